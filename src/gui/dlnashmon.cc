@@ -136,7 +136,9 @@ void gbtNashMonitorDialog::Start(gbtAnalysisOutput *p_command)
     os.SetMode(wxEOL_UNIX);
     os.WriteString(str);
     str.Remove(0, m_process->GetOutputStream()->LastWrite());
-    wxMilliSleep(100);
+    if (str.length() > 0) {
+      wxMilliSleep(100);
+    }
   }
   m_process->CloseOutput();
 
@@ -145,19 +147,39 @@ void gbtNashMonitorDialog::Start(gbtAnalysisOutput *p_command)
   m_timer.Start(1000, false);
 }
 
-void gbtNashMonitorDialog::OnIdle(wxIdleEvent &p_event)
+//
+// Reads the lines of output currently available from the solver,
+// up to a limit so the dialog stays responsive if the solver is
+// producing output faster than we can take it.  The views are
+// updated once for the whole batch rather than once per profile.
+//
+void gbtNashMonitorDialog::ReadOutput(void)
 {
-  if (!m_process)  return;
+  const int c_maxLines = 100;
+  wxArrayString lines;
 
-  if (m_process->IsInputAvailable()) {
+  while (m_process->IsInputAvailable() && (int) lines.GetCount() < c_maxLines) {
     wxTextInputStream tis(*m_process->GetInputStream());
 
     wxString msg;
     msg << tis.ReadLine();
+    if (msg != wxT("")) {
+      lines.Add(msg);
+    }
+  }
 
-    m_doc->DoAddOutput(*m_output, msg);
+  if (!lines.IsEmpty()) {
+    m_doc->DoAddOutput(*m_output, lines);
     m_countText->SetLabel(wxString::Format(wxT("Number of equilibria found so far: %d"), m_output->NumProfiles()));
+  }
+}
 
+void gbtNashMonitorDialog::OnIdle(wxIdleEvent &p_event)
+{
+  if (!m_process)  return;
+
+  if (m_process->IsInputAvailable()) {
+    ReadOutput();
     p_event.RequestMore();
   }
   else {
@@ -176,15 +198,7 @@ void gbtNashMonitorDialog::OnEndProcess(wxProcessEvent &p_event)
   m_timer.Stop();
 
   while (m_process->IsInputAvailable()) {
-    wxTextInputStream tis(*m_process->GetInputStream());
-
-    wxString msg;
-    msg << tis.ReadLine();
-
-    if (msg != wxT("")) {
-      m_doc->DoAddOutput(*m_output, msg);
-      m_countText->SetLabel(wxString::Format(wxT("Number of equilibria found so far: %d"), m_output->NumProfiles()));
-    }
+    ReadOutput();
   }
 
   if (p_event.GetExitCode() == 0) {
@@ -39,6 +39,7 @@ private:
   gbtAnalysisOutput *m_output;
   
   void Start(gbtAnalysisOutput *);
+  void ReadOutput(void);
 
   void OnStop(wxCommandEvent &);
   void OnTimer(wxTimerEvent &);
@@ -764,7 +764,9 @@ void LogitMixedDialog::Start(void)
     os.SetMode(wxEOL_UNIX);
     os.WriteString(str);
     str.Remove(0, m_process->GetOutputStream()->LastWrite());
-    wxMilliSleep(100);
+    if (str.length() > 0) {
+      wxMilliSleep(100);
+    }
   }
   m_process->CloseOutput();
 
@@ -776,14 +778,17 @@ void LogitMixedDialog::OnIdle(wxIdleEvent &p_event)
   if (!m_process)  return;
 
   if (m_process->IsInputAvailable()) {
-    wxTextInputStream tis(*m_process->GetInputStream());
+    // Take the points already computed in one go, up to a limit
+    for (int i = 0; i < 100 && m_process->IsInputAvailable(); i++) {
+      wxTextInputStream tis(*m_process->GetInputStream());
 
-    wxString msg;
-    msg << tis.ReadLine();
-    m_plot->AddProfile(msg);
-    //m_mixedList->AddProfile(msg, false);
-    m_output += msg;
-    m_output += wxT("\n");
+      wxString msg;
+      msg << tis.ReadLine();
+      m_plot->AddProfile(msg);
+      //m_mixedList->AddProfile(msg, false);
+      m_output += msg;
+      m_output += wxT("\n");
+    }
 
     p_event.RequestMore();
   }
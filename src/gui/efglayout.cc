@@ -41,7 +41,7 @@ gbtNodeEntry::gbtNodeEntry(Gambit::GameNode p_node)
     m_size(20), m_token(GBT_NODE_TOKEN_CIRCLE),
     m_branchStyle(GBT_BRANCH_STYLE_LINE), m_branchLabel(GBT_BRANCH_LABEL_HORIZONTAL),
     m_branchLength(0),
-    m_sublevel(0), m_actionProb(0)
+    m_sublevel(0), m_actionProb(0), m_labelsValid(false)
 { }
 
 int gbtNodeEntry::GetChildNumber(void) const
@@ -551,12 +551,12 @@ gbtNodeEntry *gbtTreeLayout::GetValidChild(Gambit::GameNode e)
 
 gbtNodeEntry *gbtTreeLayout::GetEntry(Gambit::GameNode p_node) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->GetNode() == p_node) {
-      return m_nodeList[i];
-    }
-  }
-  return 0;
+  if (!p_node) return 0;
+  int number = p_node->GetNumber();
+  if (number < 1 || number > m_nodeTable.Length()) return 0;
+  gbtNodeEntry *entry = m_nodeTable[number];
+  // The node table is stale if the tree was edited since it was built
+  return (entry && entry->GetNode() == p_node) ? entry : 0;
 }
 
 Gambit::GameNode gbtTreeLayout::PriorSameLevel(Gambit::GameNode p_node) const
@@ -663,73 +663,56 @@ int gbtTreeLayout::LayoutSubtree(Gambit::GameNode p_node, const Gambit::Behavior
 }
 
 //
-// Checks if there are any nodes in the same infoset as e that are either
-// on the same level (if SHOWISET_SAME) or on any level (if SHOWISET_ALL)
+// Sets the next member of each entry to the next entry in the list in
+// the same infoset as it, either on the same level (if SHOWISET_SAME)
+// or on any level (if SHOWISET_ALL).  This is done in one backwards
+// pass over the list, remembering the last entry seen for each infoset.
 //
-gbtNodeEntry *gbtTreeLayout::NextInfoset(gbtNodeEntry *e)
+void gbtTreeLayout::FindNextMembers(void)
 {
-  const gbtStyle &draw_settings = m_doc->GetStyle();
+  bool anyLevel = (m_doc->GetStyle().InfosetConnect() == GBT_INFOSET_CONNECT_ALL);
+  std::map<std::pair<Gambit::GameInfosetRep *, int>, gbtNodeEntry *> next;
   
-  for (int pos = m_nodeList.Find(e) + 1; pos <= m_nodeList.Length(); pos++) {
-    gbtNodeEntry *e1 = m_nodeList[pos];
-    // infosets are the same and the nodes are on the same level
-    if (e->GetNode()->GetInfoset() == e1->GetNode()->GetInfoset()) {
-      if (draw_settings.InfosetConnect() == GBT_INFOSET_CONNECT_ALL) {
-	return e1;
-      }
-      else if (e->GetLevel() == e1->GetLevel()) {
-	return e1;
-      }
-    }
+  for (int pos = m_nodeList.Length(); pos >= 1; pos--) {
+    gbtNodeEntry *e = m_nodeList[pos];
+    std::pair<Gambit::GameInfosetRep *, int> key(e->GetNode()->GetInfoset(),
+						  (anyLevel) ? -1 : e->GetLevel());
+    std::map<std::pair<Gambit::GameInfosetRep *, int>, gbtNodeEntry *>::iterator member = next.find(key);
+    e->SetNextMember((member != next.end()) ? member->second : 0);
+    next[key] = e;
   }
-  return 0;
 }
 
 //
 // CheckInfosetEntry.  Checks how many infoset lines are to be drawn at each
 // level, spaces them by setting each infoset's node's num to the previous
 // infoset node+1.  Also lengthens the nodes by the amount of space taken up
-// by the infoset lines.
+// by the infoset lines.  Assumes the next members have been set by
+// FindNextMembers().
 //
 void gbtTreeLayout::CheckInfosetEntry(gbtNodeEntry *e)
 {
-  int pos;
-  gbtNodeEntry *infoset_entry, *e1;
   // Check if the infoset this entry belongs to (on this level) has already
   // been processed.  If so, make this entry->num the same as the one already
   // processed and return
-  infoset_entry = NextInfoset(e);
-  for (pos = 1; pos <= m_nodeList.Length(); pos++) {
-    e1 = m_nodeList[pos];
-    // if the infosets are the same and they are on the same level and e1 has been processed
-    if (e->GetNode()->GetInfoset() == e1->GetNode()->GetInfoset() && 
-	e->GetLevel() == e1->GetLevel() && e1->GetSublevel() > 0) {
-      e->SetSublevel(e1->GetSublevel());
-      if (infoset_entry) {
-	e->SetNextMember(infoset_entry);
-      }
-      return;
-    }
+  std::pair<Gambit::GameInfosetRep *, int> key(e->GetNode()->GetInfoset(),
+						e->GetLevel());
+  std::map<std::pair<Gambit::GameInfosetRep *, int>, int>::iterator processed = m_sublevels.find(key);
+  if (processed != m_sublevels.end()) {
+    e->SetSublevel(processed->second);
+    return;
   }
     
   // If we got here, this entry does not belong to any processed infoset yet.
   // Check if it belongs to ANY infoset, if not just return
-  if (!infoset_entry) return;
+  if (!e->GetNextMember()) return;
     
   // If we got here, then this entry is new and is connected to other entries
   // find the entry on the same level with the maximum num.
   // This entry will have num = num+1.
-  int num = 0;
-  for (pos = 1; pos <= m_nodeList.Length(); pos++) {
-    e1 = m_nodeList[pos];
-    // Find the max num for this level
-    if (e->GetLevel() == e1->GetLevel())  {
-      num = std::max(e1->GetSublevel(), num);
-    }
-  }
-  num++;
+  int num = ++m_maxSublevel[e->GetLevel()];
   e->SetSublevel(num);
-  e->SetNextMember(infoset_entry);
+  m_sublevels[key] = num;
 }
 
 void gbtTreeLayout::FillInfosetTable(Gambit::GameNode n, const Gambit::BehaviorSupportProfile &cur_sup)
@@ -810,6 +793,10 @@ void gbtTreeLayout::Layout(const Gambit::BehaviorSupportProfile &p_support)
 
   const gbtStyle &draw_settings = m_doc->GetStyle();
   if (draw_settings.InfosetConnect() != GBT_INFOSET_CONNECT_NONE) {
+    FindNextMembers();
+    m_sublevels.clear();
+    m_maxSublevel = Gambit::Array<int>(0, m_maxLevel);
+    for (int i = 0; i <= m_maxLevel; m_maxSublevel[i++] = 0);
     // FIXME! This causes lines to disappear... sometimes.
     FillInfosetTable(m_doc->GetGame()->GetRoot(), p_support);
     UpdateTableInfosets();
@@ -827,6 +814,7 @@ void gbtTreeLayout::BuildNodeList(Gambit::GameNode p_node, const Gambit::Behavio
   gbtNodeEntry *entry = new gbtNodeEntry(p_node);
   entry->SetStyle(&m_doc->GetStyle());
   m_nodeList.Append(entry);
+  m_nodeTable[p_node->GetNumber()] = entry;
   entry->SetLevel(p_level);
   if (m_doc->GetStyle().RootReachable()) {
     Gambit::GameInfoset infoset = p_node->GetInfoset();
@@ -858,48 +846,64 @@ void gbtTreeLayout::BuildNodeList(const Gambit::BehaviorSupportProfile &p_suppor
     delete m_nodeList.Remove(1);
   }
 
+  m_nodeTable = Gambit::Array<gbtNodeEntry *>(m_doc->GetGame()->NumNodes());
+  for (int i = 1; i <= m_nodeTable.Length(); m_nodeTable[i++] = 0);
+
   m_maxLevel = 0;
   BuildNodeList(m_doc->GetGame()->GetRoot(), p_support, 0);
 }
 
 
+//
+// Formatting the labels can be expensive, as it may involve evaluating
+// the current profile at each node.  Labels are therefore only marked
+// out of date here, and are generated when the entry is first drawn
+// within the visible part of the tree.
+//
 void gbtTreeLayout::GenerateLabels(void)
 {
   const gbtStyle &settings = m_doc->GetStyle();
   for (int i = 1; i <= m_nodeList.Length(); i++) {
     gbtNodeEntry *entry = m_nodeList[i];
-    entry->SetNodeAboveLabel(CreateNodeLabel(entry,
-					     settings.NodeAboveLabel()));
     entry->SetNodeAboveFont(settings.GetFont());
-    entry->SetNodeBelowLabel(CreateNodeLabel(entry,
-					     settings.NodeBelowLabel()));
     entry->SetNodeBelowFont(settings.GetFont());
-    if (entry->GetChildNumber() > 0) {
-      entry->SetBranchAboveLabel(CreateBranchLabel(entry,
-						   settings.BranchAboveLabel()));
-      entry->SetBranchAboveFont(settings.GetFont());
-      entry->SetBranchBelowLabel(CreateBranchLabel(entry,
-						   settings.BranchBelowLabel()));
-      entry->SetBranchBelowFont(settings.GetFont());
-
-      Gambit::GameNode parent = entry->GetNode()->GetParent();
-      if (parent->GetPlayer()->IsChance()) {
-	entry->SetActionProb(parent->GetInfoset()->GetActionProb(entry->GetChildNumber(), (double) 0));
-      }
-      else {
-	int profile = m_doc->GetCurrentProfile();
-	if (profile > 0) {
-	  try {
-	    entry->SetActionProb((double) Gambit::lexical_cast<Gambit::Rational>(m_doc->GetProfiles().GetActionProb(parent, entry->GetChildNumber())));
-	  }
-	  catch (ValueException &) {
-	    // This occurs when the probability is undefined
-	    entry->SetActionProb(0.0);
-	  }
+    entry->SetBranchAboveFont(settings.GetFont());
+    entry->SetBranchBelowFont(settings.GetFont());
+    entry->SetLabelsValid(false);
+  }
+}
+
+void gbtTreeLayout::GenerateLabels(gbtNodeEntry *entry) const
+{
+  const gbtStyle &settings = m_doc->GetStyle();
+  entry->SetNodeAboveLabel(CreateNodeLabel(entry,
+					   settings.NodeAboveLabel()));
+  entry->SetNodeBelowLabel(CreateNodeLabel(entry,
+					   settings.NodeBelowLabel()));
+  if (entry->GetChildNumber() > 0) {
+    entry->SetBranchAboveLabel(CreateBranchLabel(entry,
+						 settings.BranchAboveLabel()));
+    entry->SetBranchBelowLabel(CreateBranchLabel(entry,
+						 settings.BranchBelowLabel()));
+
+    Gambit::GameNode parent = entry->GetNode()->GetParent();
+    if (parent->GetPlayer()->IsChance()) {
+      entry->SetActionProb(parent->GetInfoset()->GetActionProb(entry->GetChildNumber(), (double) 0));
+    }
+    else {
+      int profile = m_doc->GetCurrentProfile();
+      if (profile > 0) {
+	try {
+	  entry->SetActionProb((double) Gambit::lexical_cast<Gambit::Rational>(m_doc->GetProfiles().GetActionProb(parent, entry->GetChildNumber())));
+	}
+	catch (ValueException &) {
+	  // This occurs when the probability is undefined
+	  entry->SetActionProb(0.0);
 	}
       }
     }
   }
+  entry->SetLabelsValid(true);
 }
 
 //
@@ -919,9 +923,28 @@ void gbtTreeLayout::RenderSubtree(wxDC &p_dc, bool p_noHints) const
 {
   const gbtStyle &settings = m_doc->GetStyle();
 
+  // Labels only need to be up to date for the entries in view.  The
+  // clipping box is enlarged by its own size on each side to allow for
+  // labels extending away from their node; if there is no clipping,
+  // for example when printing, all labels are generated.
+  wxCoord clipX, clipY, clipWidth, clipHeight;
+  p_dc.GetClippingBox(&clipX, &clipY, &clipWidth, &clipHeight);
+  wxRect visible(clipX - clipWidth, clipY - clipHeight, 
+		 3 * clipWidth, 3 * clipHeight);
+  bool clipped = (clipWidth > 0 && clipHeight > 0);
+
   for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
     gbtNodeEntry *entry = m_nodeList[pos];  
     gbtNodeEntry *parentEntry = entry->GetParent();
+
+    if (!entry->LabelsValid() &&
+	(!clipped || 
+	 visible.Intersects(wxRect(wxPoint(parentEntry->X(), 
+					   std::min(parentEntry->Y(), entry->Y())),
+				   wxPoint(entry->X() + entry->GetSize(),
+					   std::max(parentEntry->Y(), entry->Y())))))) {
+      GenerateLabels(entry);
+    }
         
     if (entry->GetChildNumber() == 1) {
       parentEntry->Draw(p_dc, m_doc->GetSelectNode(), p_noHints);
@@ -23,6 +23,8 @@
 #ifndef EFGLAYOUT_H
 #define EFGLAYOUT_H
 
+#include <map>
+
 #include "libgambit/libgambit.h"
 #include "style.h"
 #include "gamedoc.h"
@@ -54,6 +56,7 @@ private:
 
   wxFont m_nodeAboveFont, m_nodeBelowFont;
   wxFont m_branchAboveFont, m_branchBelowFont;
+  bool m_labelsValid;  // true if labels reflect the current state
 
   const gbtStyle *m_style;
 
@@ -135,6 +138,9 @@ public:
   const double &GetActionProb(void) const { return m_actionProb; }
   void SetActionProb(const double &p_prob) { m_actionProb = p_prob; }
 
+  bool LabelsValid(void) const { return m_labelsValid; }
+  void SetLabelsValid(bool p_valid) { m_labelsValid = p_valid; }
+
   void SetStyle(const gbtStyle *p_style) { m_style = p_style; }
 
   bool NodeHitTest(int p_x, int p_y) const;
@@ -168,6 +174,12 @@ class gbtTreeLayout : public gbtGameView {
 private:
   /* gbtEfgDisplay *m_parent; */
   Gambit::Array<gbtNodeEntry *> m_nodeList;
+  // Entries indexed by node number; null for nodes not displayed
+  Gambit::Array<gbtNodeEntry *> m_nodeTable;
+  // Sublevels assigned to (infoset, level) pairs, and the largest
+  // sublevel used on each level, while filling the infoset table
+  std::map<std::pair<Gambit::GameInfosetRep *, int>, int> m_sublevels;
+  Gambit::Array<int> m_maxSublevel;
   mutable int m_maxX, m_maxY, m_maxLevel;
   int m_infosetSpacing;
 
@@ -175,7 +187,7 @@ private:
 
   gbtNodeEntry *GetEntry(Gambit::GameNode) const;
 
-  gbtNodeEntry *NextInfoset(gbtNodeEntry *);
+  void FindNextMembers(void);
   void CheckInfosetEntry(gbtNodeEntry *);
 
   void BuildNodeList(Gambit::GameNode, const Gambit::BehaviorSupportProfile &, int);
@@ -187,6 +199,7 @@ private:
 
   wxString CreateNodeLabel(const gbtNodeEntry *, int) const;
   wxString CreateBranchLabel(const gbtNodeEntry *, int) const;
+  void GenerateLabels(gbtNodeEntry *) const;
 
   void RenderSubtree(wxDC &dc, bool p_noHints) const;
 
@@ -27,7 +27,6 @@
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
 #endif  // WX_PRECOMP
-#include <wx/filename.h>       // used to create temp files for undo/redo
 
 #include "libgambit/libgambit.h"
 #include "libgambit/tinyxml.h"    // for XML parser for LoadDocument()
@@ -182,6 +181,226 @@ bool gbtStrategyDominanceStack::PreviousLevel(void)
   }
 }
 
+//=========================================================================
+//                       Undoable commands on the game
+//=========================================================================
+
+// Use anonymous namespace to make these helpers private
+namespace {
+
+GamePlayer GetPlayer(const Game &p_game, int p_number)
+{
+  return (p_number == 0) ? p_game->GetChance() : p_game->GetPlayer(p_number);
+}
+
+GameInfoset GetInfoset(const Game &p_game, int p_player, int p_infoset)
+{
+  return GetPlayer(p_game, p_player)->GetInfoset(p_infoset);
+}
+
+GameOutcome GetOutcome(const Game &p_game, int p_number)
+{
+  return (p_number == 0) ? GameOutcome(0) : p_game->GetOutcome(p_number);
+}
+
+int GetOutcomeNumber(const GameOutcome &p_outcome)
+{
+  return (p_outcome) ? p_outcome->GetNumber() : 0;
+}
+
+//
+// Nodes are located by the numbers of the actions taken on the way
+// down from the root.
+//
+Array<int> GetNodePath(GameNode p_node)
+{
+  Array<int> path;
+  for (; p_node->GetParent(); p_node = p_node->GetParent()) {
+    path.Insert(p_node->GetPriorAction()->GetNumber(), 1);
+  }
+  return path;
+}
+
+GameNode GetNode(const Game &p_game, const Array<int> &p_path)
+{
+  GameNode node = p_game->GetRoot();
+  for (int i = 1; i <= p_path.Length(); i++) {
+    node = node->GetChild(p_path[i]);
+  }
+  return node;
+}
+
+class gbtTitleCommand : public gbtGameCommand {
+private:
+  std::string m_oldTitle, m_oldComment, m_newTitle, m_newComment;
+
+public:
+  gbtTitleCommand(const Game &p_game, 
+		  const std::string &p_title, const std::string &p_comment)
+    : m_oldTitle(p_game->GetTitle()), m_oldComment(p_game->GetComment()),
+      m_newTitle(p_title), m_newComment(p_comment) { }
+  virtual ~gbtTitleCommand() { }
+
+  gbtGameModificationType GetModification(void) const
+  { return GBT_DOC_MODIFIED_LABELS; }
+
+  void Do(const Game &p_game)
+  { p_game->SetTitle(m_newTitle);  p_game->SetComment(m_newComment); }
+  void Undo(const Game &p_game)
+  { p_game->SetTitle(m_oldTitle);  p_game->SetComment(m_oldComment); }
+};
+
+class gbtLabelCommand : public gbtGameCommand {
+private:
+  enum { PLAYER, STRATEGY, INFOSET, ACTION, NODE } m_type;
+  Array<int> m_index;
+  std::string m_oldLabel, m_newLabel;
+
+  void SetLabel(const Game &, const std::string &) const;
+
+public:
+  gbtLabelCommand(const GamePlayer &p_player, const std::string &p_label)
+    : m_type(PLAYER), m_oldLabel(p_player->GetLabel()), m_newLabel(p_label)
+  { m_index.Append(p_player->GetNumber()); }
+  gbtLabelCommand(const GameStrategy &p_strategy, const std::string &p_label)
+    : m_type(STRATEGY), m_oldLabel(p_strategy->GetLabel()), m_newLabel(p_label)
+  { 
+    m_index.Append(p_strategy->GetPlayer()->GetNumber()); 
+    m_index.Append(p_strategy->GetNumber()); 
+  }
+  gbtLabelCommand(const GameInfoset &p_infoset, const std::string &p_label)
+    : m_type(INFOSET), m_oldLabel(p_infoset->GetLabel()), m_newLabel(p_label)
+  { 
+    m_index.Append(p_infoset->GetPlayer()->GetNumber()); 
+    m_index.Append(p_infoset->GetNumber()); 
+  }
+  gbtLabelCommand(const GameAction &p_action, const std::string &p_label)
+    : m_type(ACTION), m_oldLabel(p_action->GetLabel()), m_newLabel(p_label)
+  { 
+    m_index.Append(p_action->GetInfoset()->GetPlayer()->GetNumber()); 
+    m_index.Append(p_action->GetInfoset()->GetNumber()); 
+    m_index.Append(p_action->GetNumber()); 
+  }
+  gbtLabelCommand(const GameNode &p_node, const std::string &p_label)
+    : m_type(NODE), m_index(GetNodePath(p_node)),
+      m_oldLabel(p_node->GetLabel()), m_newLabel(p_label) { }
+  virtual ~gbtLabelCommand() { }
+
+  gbtGameModificationType GetModification(void) const
+  { return GBT_DOC_MODIFIED_LABELS; }
+
+  void Do(const Game &p_game)    { SetLabel(p_game, m_newLabel); }
+  void Undo(const Game &p_game)  { SetLabel(p_game, m_oldLabel); }
+};
+
+void gbtLabelCommand::SetLabel(const Game &p_game, 
+			       const std::string &p_label) const
+{
+  switch (m_type) {
+  case PLAYER:
+    GetPlayer(p_game, m_index[1])->SetLabel(p_label);
+    break;
+  case STRATEGY:
+    GetPlayer(p_game, m_index[1])->GetStrategy(m_index[2])->SetLabel(p_label);
+    break;
+  case INFOSET:
+    GetInfoset(p_game, m_index[1], m_index[2])->SetLabel(p_label);
+    break;
+  case ACTION:
+    GetInfoset(p_game, m_index[1], m_index[2])->GetAction(m_index[3])->SetLabel(p_label);
+    break;
+  case NODE:
+    GetNode(p_game, m_index)->SetLabel(p_label);
+    break;
+  }
+}
+
+class gbtActionProbCommand : public gbtGameCommand {
+private:
+  int m_player, m_infoset, m_action;
+  std::string m_oldProb, m_newProb;
+
+public:
+  gbtActionProbCommand(const GameInfoset &p_infoset, int p_action,
+		       const std::string &p_prob)
+    : m_player(p_infoset->GetPlayer()->GetNumber()),
+      m_infoset(p_infoset->GetNumber()), m_action(p_action),
+      m_oldProb(p_infoset->GetActionProb(p_action, std::string())), m_newProb(p_prob)
+  { }
+  virtual ~gbtActionProbCommand() { }
+
+  gbtGameModificationType GetModification(void) const
+  { return GBT_DOC_MODIFIED_PAYOFFS; }
+
+  void Do(const Game &p_game)
+  { GetInfoset(p_game, m_player, m_infoset)->SetActionProb(m_action, m_newProb); }
+  void Undo(const Game &p_game)
+  { GetInfoset(p_game, m_player, m_infoset)->SetActionProb(m_action, m_oldProb); }
+};
+
+class gbtNodeOutcomeCommand : public gbtGameCommand {
+private:
+  Array<int> m_path;
+  int m_oldOutcome, m_newOutcome;
+
+public:
+  gbtNodeOutcomeCommand(const GameNode &p_node, const GameOutcome &p_outcome)
+    : m_path(GetNodePath(p_node)), 
+      m_oldOutcome(GetOutcomeNumber(p_node->GetOutcome())),
+      m_newOutcome(GetOutcomeNumber(p_outcome)) { }
+  virtual ~gbtNodeOutcomeCommand() { }
+
+  gbtGameModificationType GetModification(void) const
+  { return GBT_DOC_MODIFIED_PAYOFFS; }
+
+  void Do(const Game &p_game)
+  { GetNode(p_game, m_path)->SetOutcome(GetOutcome(p_game, m_newOutcome)); }
+  void Undo(const Game &p_game)
+  { GetNode(p_game, m_path)->SetOutcome(GetOutcome(p_game, m_oldOutcome)); }
+};
+
+class gbtPayoffCommand : public gbtGameCommand {
+private:
+  int m_outcome, m_player;
+  std::string m_oldPayoff, m_newPayoff;
+
+public:
+  gbtPayoffCommand(const GameOutcome &p_outcome, int p_player,
+		   const std::string &p_payoff)
+    : m_outcome(p_outcome->GetNumber()), m_player(p_player),
+      m_oldPayoff(p_outcome->GetPayoff<std::string>(p_player)),
+      m_newPayoff(p_payoff) { }
+  virtual ~gbtPayoffCommand() { }
+
+  gbtGameModificationType GetModification(void) const
+  { return GBT_DOC_MODIFIED_PAYOFFS; }
+
+  void Do(const Game &p_game)
+  { p_game->GetOutcome(m_outcome)->SetPayoff(m_player, m_newPayoff); }
+  void Undo(const Game &p_game)
+  { p_game->GetOutcome(m_outcome)->SetPayoff(m_player, m_oldPayoff); }
+};
+
+}  // end anonymous namespace
+
+//=========================================================================
+//                          class gbtUndoEntry
+//=========================================================================
+
+gbtUndoEntry::~gbtUndoEntry()
+{
+  delete m_command;
+  DiscardProfiles();
+}
+
+void gbtUndoEntry::DiscardProfiles(void)
+{
+  while (m_profiles.Length() > 0) {
+    delete m_profiles.Remove(1);
+  }
+  m_currentProfileList = 0;
+}
+
 //=========================================================================
 //                          class gbtGameDocument
 //=========================================================================
@@ -194,14 +413,18 @@ gbtGameDocument::gbtGameDocument(Gambit::Game p_game)
 {
   wxGetApp().AddDocument(this);
 
-  std::ostringstream s;
-  SaveDocument(s);
-  m_undoList.Append(s.str());
+  gbtUndoEntry *entry = new gbtUndoEntry(0);
+  SaveCheckpoint(entry);
+  m_undoList.Append(entry);
 }
 
 gbtGameDocument::~gbtGameDocument()
 {
   wxGetApp().RemoveDocument(this);
+  ClearRedoList();
+  while (m_undoList.Length() > 0) {
+    delete m_undoList.Remove(1);
+  }
 }
 
 bool gbtGameDocument::LoadDocument(const wxString &p_filename,
@@ -213,6 +436,21 @@ bool gbtGameDocument::LoadDocument(const wxString &p_filename,
     return false;
   }
 
+  if (!ReadDocument(doc)) {
+    return false;
+  }
+
+  if (p_saveUndo) {
+    gbtUndoEntry *entry = new gbtUndoEntry(0);
+    SaveCheckpoint(entry);
+    m_undoList.Append(entry);
+  }
+
+  return true;
+}
+
+bool gbtGameDocument::ReadDocument(TiXmlDocument &doc)
+{
   TiXmlNode *docroot = doc.FirstChild("gambit:document");
 
   if (!docroot) {
@@ -307,12 +545,6 @@ bool gbtGameDocument::LoadDocument(const wxString &p_filename,
     m_style.SetNumDecimals(numDecimals);
   }
 
-  if (p_saveUndo) {
-    std::ostringstream s;
-    SaveDocument(s);
-    m_undoList.Append(s.str());
-  }
-
   return true;
 }
 
@@ -355,15 +587,22 @@ void gbtGameDocument::SaveDocument(std::ostream &p_file) const
   p_file << "</gambit:document>\n";
 }
 
-void gbtGameDocument::UpdateViews(gbtGameModificationType p_modifications)
+//
+// Number of consecutive command entries in the undo history after which
+// a checkpoint is stored again, bounding the number of commands which
+// have to be replayed when restoring an earlier state.
+//
+const int GBT_UNDO_CHECKPOINT_INTERVAL = 50;
+
+void gbtGameDocument::UpdateViews(gbtGameModificationType p_modifications,
+				  gbtGameCommand *p_command)
 {
+  gbtUndoEntry *entry = 0;
+
   if (p_modifications != GBT_DOC_MODIFIED_NONE) {
     m_modified = true;
-    m_redoList = Gambit::List<std::string>();
-
-    std::ostringstream s;
-    SaveDocument(s);
-    m_undoList.Append(s.str());
+    ClearRedoList();
+    entry = new gbtUndoEntry(p_command);
   }
 
   if (p_modifications == GBT_DOC_MODIFIED_GAME ||
@@ -374,16 +613,44 @@ void gbtGameDocument::UpdateViews(gbtGameModificationType p_modifications)
     // Even though modifications only to payoffs doesn't make the
     // computed profiles invalid for the edited game, it does mean
     // that, in general, they won't be Nash.  For now, to avoid confusion,
-    // we will wipe them out.
-    while (m_profiles.Length() > 0) {
-      delete m_profiles.Remove(1);
+    // we will wipe them out.  If the edit can be undone in place,
+    // they are set aside so undoing it brings them back.
+    if (p_command) {
+      SwapProfiles(entry);
     }
-    m_currentProfileList = 0;
+    else {
+      while (m_profiles.Length() > 0) {
+	delete m_profiles.Remove(1);
+      }
+      m_currentProfileList = 0;
+    }
+  }
+
+  if (entry) {
+    int commands = 0;
+    for (int i = m_undoList.Length(); 
+	 i >= 1 && !m_undoList[i]->HasCheckpoint(); i--, commands++);
+    if (!p_command || commands + 1 >= GBT_UNDO_CHECKPOINT_INTERVAL) {
+      SaveCheckpoint(entry);
+    }
+    m_undoList.Append(entry);
   }
 
   for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
 }
 
+void gbtGameDocument::ApplyCommand(gbtGameCommand *p_command)
+{
+  try {
+    p_command->Do(m_game);
+  }
+  catch (...) {
+    delete p_command;
+    throw;
+  }
+  UpdateViews(p_command->GetModification(), p_command);
+}
+
 void gbtGameDocument::PostPendingChanges(void)
 {
   for (int i = 1; i <= m_views.Length(); m_views[i++]->PostPendingChanges());
@@ -405,17 +672,31 @@ void gbtGameDocument::SetStyle(const gbtStyle &p_style)
 
 //
 // A word about the undo and redo features:
-// We store a list of the textual representation of games.  We don't
-// store other aspects of the state (e.g., profiles) as yet.
-// The "undo" list includes the representation of the current state
-// of the game (hence, CanUndo() only returns true when the list has
-// more than one element.
+// The undo list holds one entry per modification of the document, the
+// last one corresponding to the current state (hence, CanUndo() only
+// returns true when the list has more than one element).  Labels,
+// payoffs, outcome assignments and chance probabilities are recorded as
+// commands, which are undone and redone in place on the live game.
+// Other modifications store a checkpoint, the textual representation of
+// the whole document; to step back over one of these, the nearest
+// earlier checkpoint is reloaded and the commands after it replayed.
 //
-void gbtGameDocument::Undo(void)
+void gbtGameDocument::SaveCheckpoint(gbtUndoEntry *p_entry) const
 {
-  // The current game is at the end of the undo list; move it to the redo list
-  m_redoList.Append(m_undoList[m_undoList.Length()]);
-  m_undoList.Remove(m_undoList.Length());
+  std::ostringstream s;
+  SaveDocument(s);
+  p_entry->m_checkpoint = s.str();
+}
+
+void gbtGameDocument::RestoreCheckpoint(const std::string &p_checkpoint)
+{
+  // Profile lists set aside by commands refer to the game being replaced
+  for (int i = 1; i <= m_undoList.Length(); i++) {
+    m_undoList[i]->DiscardProfiles();
+  }
+  for (int i = 1; i <= m_redoList.Length(); i++) {
+    m_redoList[i]->DiscardProfiles();
+  }
 
   m_game = 0;
 
@@ -424,36 +705,89 @@ void gbtGameDocument::Undo(void)
   }
   m_currentProfileList = 0;
 
-  wxString tempfile = wxFileName::CreateTempFileName(wxT("gambit"));
-  std::ofstream f((const char *) tempfile.mb_str());
-  f << m_undoList[m_undoList.Length()] << std::endl;
-  f.close();
+  TiXmlDocument doc;
+  doc.Parse(p_checkpoint.c_str());
+  ReadDocument(doc);
+}
 
-  LoadDocument(tempfile, false);
-  wxRemoveFile(tempfile);
+void gbtGameDocument::RestoreUndoState(int p_index)
+{
+  int start = p_index;
+  while (!m_undoList[start]->HasCheckpoint()) start--;
 
-  for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
+  RestoreCheckpoint(m_undoList[start]->m_checkpoint);
+
+  for (int i = start + 1; i <= p_index; i++) {
+    gbtGameCommand *command = m_undoList[i]->m_command;
+    command->Do(m_game);
+    if (command->GetModification() == GBT_DOC_MODIFIED_PAYOFFS) {
+      while (m_profiles.Length() > 0) {
+	delete m_profiles.Remove(1);
+      }
+      m_currentProfileList = 0;
+    }
+  }
+  if (start < p_index) {
+    m_behavSupports.Reset();
+    m_stratSupports.Reset();
+  }
 }
 
-void gbtGameDocument::Redo(void)
+void gbtGameDocument::SwapProfiles(gbtUndoEntry *p_entry)
 {
-  m_undoList.Append(m_redoList[m_redoList.Length()]);
-  m_redoList.Remove(m_redoList.Length());
+  Gambit::List<gbtAnalysisOutput *> profiles = m_profiles;
+  m_profiles = p_entry->m_profiles;
+  p_entry->m_profiles = profiles;
 
-  m_game = 0;
+  int current = m_currentProfileList;
+  m_currentProfileList = p_entry->m_currentProfileList;
+  p_entry->m_currentProfileList = current;
+}
 
-  while (m_profiles.Length() > 0) {
-    delete m_profiles.Remove(1);
+void gbtGameDocument::ClearRedoList(void)
+{
+  while (m_redoList.Length() > 0) {
+    delete m_redoList.Remove(1);
   }
-  m_currentProfileList = 0;
+}
+
+void gbtGameDocument::Undo(void)
+{
+  // The current state is at the end of the undo list; move it to the redo list
+  gbtUndoEntry *entry = m_undoList.Remove(m_undoList.Length());
+  m_redoList.Append(entry);
+
+  if (entry->m_command) {
+    entry->m_command->Undo(m_game);
+    if (entry->m_command->GetModification() == GBT_DOC_MODIFIED_PAYOFFS) {
+      m_behavSupports.Reset();
+      m_stratSupports.Reset();
+      SwapProfiles(entry);
+    }
+  }
+  else {
+    RestoreUndoState(m_undoList.Length());
+  }
+
+  for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
+}
 
-  wxString tempfile = wxFileName::CreateTempFileName(wxT("gambit"));
-  std::ofstream f((const char *) tempfile.mb_str());
-  f << m_undoList[m_undoList.Length()] << std::endl;
-  f.close();
+void gbtGameDocument::Redo(void)
+{
+  gbtUndoEntry *entry = m_redoList.Remove(m_redoList.Length());
+  m_undoList.Append(entry);
 
-  LoadDocument(tempfile, false);
-  wxRemoveFile(tempfile);
+  if (entry->m_command) {
+    entry->m_command->Do(m_game);
+    if (entry->m_command->GetModification() == GBT_DOC_MODIFIED_PAYOFFS) {
+      m_behavSupports.Reset();
+      m_stratSupports.Reset();
+      SwapProfiles(entry);
+    }
+  }
+  else {
+    RestoreCheckpoint(entry->m_checkpoint);
+  }
 
   for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
 }
@@ -629,9 +963,9 @@ void gbtGameDocument::DoExportNfg(const wxString &p_filename)
 void gbtGameDocument::DoSetTitle(const wxString &p_title, 
 				 const wxString &p_comment)
 {
-  m_game->SetTitle(static_cast<const char *>(p_title.mb_str()));
-  m_game->SetComment(static_cast<const char *>(p_comment.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  ApplyCommand(new gbtTitleCommand(m_game,
+				   static_cast<const char *>(p_title.mb_str()),
+				   static_cast<const char *>(p_comment.mb_str())));
 }
 
 void gbtGameDocument::DoNewPlayer(void)
@@ -648,8 +982,8 @@ void gbtGameDocument::DoNewPlayer(void)
 void gbtGameDocument::DoSetPlayerLabel(GamePlayer p_player,
 				       const wxString &p_label)
 {
-  p_player->SetLabel(static_cast<const char *>(p_label.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  ApplyCommand(new gbtLabelCommand(p_player, 
+				   static_cast<const char *>(p_label.mb_str())));
 }
 
 void gbtGameDocument::DoNewStrategy(GamePlayer p_player)
@@ -668,30 +1002,30 @@ void gbtGameDocument::DoDeleteStrategy(GameStrategy p_strategy)
 void gbtGameDocument::DoSetStrategyLabel(GameStrategy p_strategy,
 					 const wxString &p_label)
 {
-  p_strategy->SetLabel(static_cast<const char *>(p_label.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  ApplyCommand(new gbtLabelCommand(p_strategy, 
+				   static_cast<const char *>(p_label.mb_str())));
 }
 
 void gbtGameDocument::DoSetInfosetLabel(GameInfoset p_infoset,
 					const wxString &p_label)
 {
-  p_infoset->SetLabel(static_cast<const char *>(p_label.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  ApplyCommand(new gbtLabelCommand(p_infoset, 
+				   static_cast<const char *>(p_label.mb_str())));
 }
 
 void gbtGameDocument::DoSetActionLabel(GameAction p_action,
 				       const wxString &p_label)
 {
-  p_action->SetLabel(static_cast<const char *>(p_label.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  ApplyCommand(new gbtLabelCommand(p_action, 
+				   static_cast<const char *>(p_label.mb_str())));
 }
 
 void gbtGameDocument::DoSetActionProb(GameInfoset p_infoset,
 				      unsigned int p_action,
 				      const wxString &p_prob)
 {
-  p_infoset->SetActionProb(p_action, static_cast<const char *>(p_prob.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  ApplyCommand(new gbtActionProbCommand(p_infoset, p_action,
+					static_cast<const char *>(p_prob.mb_str())));
 }
 
 void gbtGameDocument::DoSetInfoset(GameNode p_node, GameInfoset p_infoset)
@@ -722,8 +1056,8 @@ void gbtGameDocument::DoInsertAction(GameNode p_node)
 
 void gbtGameDocument::DoSetNodeLabel(GameNode p_node, const wxString &p_label)
 {
-  p_node->SetLabel(static_cast<const char *>(p_label.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  ApplyCommand(new gbtLabelCommand(p_node, 
+				   static_cast<const char *>(p_label.mb_str())));
 }
 
 
@@ -806,15 +1140,13 @@ void gbtGameDocument::DoNewOutcome(const PureStrategyProfile &p_profile)
 
 void gbtGameDocument::DoSetOutcome(GameNode p_node, GameOutcome p_outcome)
 {
-  p_node->SetOutcome(p_outcome);
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  ApplyCommand(new gbtNodeOutcomeCommand(p_node, p_outcome));
 }
 
 void gbtGameDocument::DoRemoveOutcome(GameNode p_node)
 {
   if (!p_node || !p_node->GetOutcome()) return;
-  p_node->SetOutcome(0);
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  ApplyCommand(new gbtNodeOutcomeCommand(p_node, 0));
 }
 
 void gbtGameDocument::DoCopyOutcome(GameNode p_node, GameOutcome p_outcome)
@@ -831,9 +1163,8 @@ void gbtGameDocument::DoCopyOutcome(GameNode p_node, GameOutcome p_outcome)
 void gbtGameDocument::DoSetPayoff(GameOutcome p_outcome, int p_player,
 				  const wxString &p_value)
 {
-  p_outcome->SetPayoff(p_player, 
-		       static_cast<const char *>(p_value.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  ApplyCommand(new gbtPayoffCommand(p_outcome, p_player,
+				    static_cast<const char *>(p_value.mb_str())));
 }
 
 void gbtGameDocument::DoAddOutput(gbtAnalysisOutput &p_list,
@@ -842,3 +1173,15 @@ void gbtGameDocument::DoAddOutput(gbtAnalysisOutput &p_list,
   p_list.AddOutput(p_output);
   UpdateViews(GBT_DOC_MODIFIED_NONE);
 }
+
+//
+// Adds a batch of output lines, updating the views only once
+//
+void gbtGameDocument::DoAddOutput(gbtAnalysisOutput &p_list,
+				  const wxArrayString &p_output)
+{
+  for (size_t i = 0; i < p_output.GetCount(); i++) {
+    p_list.AddOutput(p_output[i]);
+  }
+  UpdateViews(GBT_DOC_MODIFIED_NONE);
+}
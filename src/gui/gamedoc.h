@@ -33,6 +33,7 @@ using namespace Gambit;
 
 class gbtGameView;
 class gbtGameDocument;
+class TiXmlDocument;
 
 //!
 //! This class manages the "stack" of supports obtained by eliminating
@@ -213,6 +214,50 @@ typedef enum {
   GBT_DOC_MODIFIED_VIEWS = 0x08
 } gbtGameModificationType;
 
+//!
+//! An edit to the game which can be undone and redone in place, against
+//! the live game, without reloading the document.  Commands refer to the
+//! objects they edit by position (player, infoset and action numbers,
+//! or the path from the root for nodes) rather than by pointer, so they
+//! stay valid when the game is rebuilt from a checkpoint.
+//!
+class gbtGameCommand {
+public:
+  virtual ~gbtGameCommand() { }
+
+  /// The kind of modification the command makes to the game
+  virtual gbtGameModificationType GetModification(void) const = 0;
+
+  /// Apply the edit to the game
+  virtual void Do(const Gambit::Game &) = 0;
+  /// Revert the edit on the game
+  virtual void Undo(const Gambit::Game &) = 0;
+};
+
+//!
+//! An entry in the undo history.  Edits which change the structure of
+//! the game are recorded as a checkpoint, that is, a full snapshot of the
+//! document after the edit.  Other edits are recorded as a command; every
+//! so often a command entry also carries a checkpoint, so that the
+//! history can be replayed from a nearby snapshot when needed.
+//!
+class gbtUndoEntry {
+public:
+  gbtGameCommand *m_command;
+  std::string m_checkpoint;
+
+  /// Profile lists set aside when the command invalidated them
+  Gambit::List<gbtAnalysisOutput *> m_profiles;
+  int m_currentProfileList;
+
+  gbtUndoEntry(gbtGameCommand *p_command)
+    : m_command(p_command), m_currentProfileList(0) { }
+  ~gbtUndoEntry();
+
+  bool HasCheckpoint(void) const { return !m_checkpoint.empty(); }
+  void DiscardProfiles(void);
+};
+
 class gbtGameDocument {
 friend class gbtGameView;
 private:
@@ -238,10 +283,18 @@ private:
   Gambit::List<gbtAnalysisOutput *> m_profiles;
   int m_currentProfileList;
 
-  Gambit::List<std::string> m_undoList, m_redoList;
+  Gambit::List<gbtUndoEntry *> m_undoList, m_redoList;
 
+  bool ReadDocument(TiXmlDocument &);
+  void SaveCheckpoint(gbtUndoEntry *) const;
+  void RestoreCheckpoint(const std::string &);
+  void RestoreUndoState(int p_index);
+  void SwapProfiles(gbtUndoEntry *);
+  void ClearRedoList(void);
 
-  void UpdateViews(gbtGameModificationType p_modifications);
+  void ApplyCommand(gbtGameCommand *);
+  void UpdateViews(gbtGameModificationType p_modifications,
+		   gbtGameCommand *p_command = 0);
 
 public:
   gbtGameDocument(Gambit::Game p_game);
@@ -381,6 +434,7 @@ public:
 		   const wxString &p_value);
 
   void DoAddOutput(gbtAnalysisOutput &p_list, const wxString &p_output);
+  void DoAddOutput(gbtAnalysisOutput &p_list, const wxArrayString &p_output);
 };
 
 class gbtGameView {
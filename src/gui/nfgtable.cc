@@ -20,6 +20,8 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <map>
+
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
@@ -152,6 +154,8 @@ class gbtRowPlayerWidget : public gbtTableWidgetBase {
 private:
   gbtGameDocument *m_doc;
   gbtTableWidget *m_table;
+  /// Formatted payoffs of recently drawn contingencies, by index
+  std::map<long, Gambit::Array<wxString> > m_cellCache;
 
   /// @name Overriding wxSheet members for data access
   //@{
@@ -361,6 +365,8 @@ class gbtColPlayerWidget : public gbtTableWidgetBase {
 private:
   gbtGameDocument *m_doc;
   gbtTableWidget *m_table;
+  /// Formatted payoffs of recently drawn contingencies, by index
+  std::map<long, Gambit::Array<wxString> > m_cellCache;
 
   /// @name Overriding wxSheet members for data access
   //@{
@@ -570,6 +576,8 @@ class gbtPayoffsWidget : public gbtTableWidgetBase {
 private:
   gbtGameDocument *m_doc;
   gbtTableWidget *m_table;
+  /// Formatted payoffs of recently drawn contingencies, by index
+  std::map<long, Gambit::Array<wxString> > m_cellCache;
 
   /// @name Overriding wxSheet members for data access
   //@{
@@ -598,6 +606,8 @@ private:
 
   /// Maps columns to corresponding player
   int ColToPlayer(int p_col) const;
+  /// Returns the formatted payoffs of the contingency containing the cell
+  const Gambit::Array<wxString> &GetPayoffs(const wxSheetCoords &);
 
 public:
   gbtPayoffsWidget(gbtTableWidget *p_parent, gbtGameDocument *p_doc);
@@ -648,16 +658,55 @@ void gbtPayoffsWidget::OnUpdate(void)
   if (newRows > GetNumberRows())  InsertRows(0, newRows - GetNumberRows());
   if (newRows < GetNumberRows())  DeleteRows(0, GetNumberRows() - newRows);
 
+  // Payoffs, the support, or the layout of players may have changed
+  m_cellCache.clear();
+
   Refresh();
 }
 
+//
+// Formatting a payoff requires building the profile for the contingency
+// and, for trees, computing the payoff by traversing the tree.  The
+// payoffs of all players in a contingency are computed together when
+// the first of its cells is drawn, and kept until the next update of
+// the document.  As only the cells in view are drawn, the cache holds
+// the visible part of the table; it is emptied when it grows beyond
+// what any reasonable window can show, to keep memory bounded when
+// scrolling through a large table.
+//
+const int GBT_MAX_CACHED_CONTINGENCIES = 10000;
+
+const Gambit::Array<wxString> &
+gbtPayoffsWidget::GetPayoffs(const wxSheetCoords &p_coords)
+{
+  int numPlayers = m_doc->NumPlayers();
+  long index = ((long) p_coords.GetRow() * m_table->NumColContingencies() +
+		p_coords.GetCol() / numPlayers);
+
+  std::map<long, Gambit::Array<wxString> >::iterator entry = 
+    m_cellCache.find(index);
+  if (entry != m_cellCache.end()) {
+    return entry->second;
+  }
+
+  if ((int) m_cellCache.size() >= GBT_MAX_CACHED_CONTINGENCIES) {
+    m_cellCache.clear();
+  }
+
+  Gambit::PureStrategyProfile profile = m_table->CellToProfile(p_coords);
+  Gambit::Array<wxString> &payoffs = m_cellCache[index];
+  payoffs = Gambit::Array<wxString>(numPlayers);
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    payoffs[pl] = wxString(Gambit::lexical_cast<std::string>(profile->GetPayoff(pl)).c_str(), *wxConvCurrent);
+  }
+  return payoffs;
+}
+
 wxString gbtPayoffsWidget::GetCellValue(const wxSheetCoords &p_coords)
 {
   if (IsLabelCell(p_coords))  return wxT("");
 
-  Gambit::PureStrategyProfile profile = m_table->CellToProfile(p_coords);
-  int player = ColToPlayer(p_coords.GetCol());
-  return wxString(Gambit::lexical_cast<std::string>(profile->GetPayoff(player)).c_str(), *wxConvCurrent);
+  return GetPayoffs(p_coords)[ColToPlayer(p_coords.GetCol())];
 }
 
 void gbtPayoffsWidget::SetCellValue(const wxSheetCoords &p_coords,
@@ -30,13 +30,26 @@ template <class T> class Array  {
 protected:
   int mindex, maxdex;
   T *data;
+  /// The last index for which storage is allocated; appending grows the
+  /// storage geometrically, so building an array by repeated appends
+  /// takes time linear in its final length
+  int maxalloc;
 
   /// Private helper function that accomplishes the insertion of an object
   int InsertAt(const T &t, int n)
   {
     if (this->mindex > n || n > this->maxdex + 1)  throw IndexException();
 
-    T *new_data = new T[++this->maxdex - this->mindex + 1] - this->mindex;
+    if (this->maxdex < this->maxalloc) {
+      for (int i = ++this->maxdex; i > n; i--) this->data[i] = this->data[i - 1];
+      this->data[n] = t;
+      return n;
+    }
+
+    int length = this->maxdex - this->mindex + 1;
+    int capacity = (length < 4) ? length + 1 : 2 * length;
+    T *new_data = new T[capacity] - this->mindex;
+    this->maxdex++;
 
     int i;
     for (i = this->mindex; i <= n - 1; i++) new_data[i] = this->data[i];
@@ -45,6 +58,7 @@ protected:
 
     if (this->data)   delete [] (this->data + this->mindex);
     this->data = new_data;
+    this->maxalloc = this->mindex + capacity - 1;
 
     return n;
   }
@@ -85,9 +99,10 @@ public:
   //@{
   /// Constructs an array of length 'len', starting at '1'
   Array(unsigned int len = 0)
-    : mindex(1), maxdex(len), data((len) ? new T[len] - 1 : 0) { } 
+    : mindex(1), maxdex(len), data((len) ? new T[len] - 1 : 0),
+      maxalloc(len) { } 
   /// Constructs an array starting at lo and ending at hi
-  Array(int lo, int hi) : mindex(lo), maxdex(hi)
+  Array(int lo, int hi) : mindex(lo), maxdex(hi), maxalloc(hi)
   {
     if (maxdex + 1 < mindex)   throw RangeException();
     data = (maxdex >= mindex) ? new T[maxdex -mindex + 1] - mindex : 0;
@@ -95,13 +110,14 @@ public:
   /// Copy the contents of another array
   Array(const Array<T> &a)
     : mindex(a.mindex), maxdex(a.maxdex),
-      data((maxdex >= mindex) ? new T[maxdex - mindex + 1] - mindex : 0)
+      data((maxdex >= mindex) ? new T[maxdex - mindex + 1] - mindex : 0),
+      maxalloc(a.maxdex)
   {
     for (int i = mindex; i <= maxdex; i++)  data[i] = a.data[i];
   }
   /// Destruct and deallocates the array
   virtual ~Array()
-  { if (maxdex >= mindex)  delete [] (data + mindex); }
+  { if (data)  delete [] (data + mindex); }
 
   /// Copy the contents of another array
   Array<T> &operator=(const Array<T> &a)
@@ -114,7 +130,7 @@ public:
       // not change.
       if (!data || (data && (mindex != a.mindex || maxdex != a.maxdex)))  {
 	if (data)   delete [] (data + mindex);
-	mindex = a.mindex;   maxdex = a.maxdex;
+	mindex = a.mindex;   maxdex = a.maxdex;   maxalloc = a.maxdex;
 	data = (maxdex >= mindex) ? new T[maxdex - mindex + 1] - mindex : 0;
       }
       
@@ -223,6 +239,7 @@ public:
 
     delete [] (this->data + this->mindex);
     this->data = new_data;
+    this->maxalloc = this->maxdex;
 
     return ret;
   }
@@ -257,6 +274,7 @@ public:
     delete [] (this->data + this->mindex);
     this->data = 0;
     this->maxdex = this->mindex - 1;
+    this->maxalloc = this->maxdex;
   }
   ///@}
 };
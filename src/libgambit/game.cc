@@ -412,6 +412,26 @@ GameExplicitRep::~GameExplicitRep()
        m_outcomes[outc++]->Invalidate());
 }
 
+//------------------------------------------------------------------------
+//               GameExplicitRep: Sharing between threads
+//------------------------------------------------------------------------
+
+void GameExplicitRep::Freeze(void)
+{
+  BuildComputedValues();
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = m_players[pl];
+    for (int st = 1; st <= player->m_strategies.Length(); st++) {
+      FreezeObject(player->m_strategies[st]);
+    }
+    FreezeObject(player);
+  }
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    FreezeObject(m_outcomes[outc]);
+  }
+  FreezeObject(this);
+}
+
 //------------------------------------------------------------------------
 //                  GameExplicitRep: General data access
 //------------------------------------------------------------------------
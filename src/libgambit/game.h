@@ -39,16 +39,22 @@ namespace Gambit {
 /// but will instead be marked as deleted.  Calling code should always
 /// be careful to check the deleted status of the object before any
 /// operations on it.
+///
+/// Objects belonging to a frozen game (see GameRep::Freeze()) do not
+/// maintain their reference counts, so that handles to them can be
+/// created and destroyed concurrently from several threads.  Frozen
+/// objects are never deleted through reference counting.
 class GameObject {
+  friend class GameRep;
 protected:
   int m_refCount;
-  bool m_valid;
+  bool m_valid, m_frozen;
 
 public:
   /// @name Lifecycle
   //@{
   /// Constructor; initializes reference count
-  GameObject(void) : m_refCount(0), m_valid(true) { }
+  GameObject(void) : m_refCount(0), m_valid(true), m_frozen(false) { }
   /// Destructor
   virtual ~GameObject() { }
   //@}
@@ -65,12 +71,19 @@ public:
   /// @name Reference counting
   //@{
   /// Increment the reference count
-  void IncRef(void) { m_refCount++; }
+  void IncRef(void) { if (!m_frozen) m_refCount++; }
   /// Decrement the reference count; delete if reference count is zero.
-  void DecRef(void) { if (!--m_refCount && !m_valid) delete this; }
+  void DecRef(void) 
+  { if (!m_frozen && !--m_refCount && !m_valid) delete this; }
   /// Returns the reference count
   int RefCount(void) const { return m_refCount; }
   //@}
+
+  /// @name Sharing between threads
+  //@{
+  /// Is the object part of a frozen game?
+  bool IsFrozen(void) const { return m_frozen; }
+  //@}
 };
 
 /// An exception thrown when attempting to dereference an invalidated object 
@@ -674,6 +687,10 @@ protected:
   virtual bool HasComputedValues(void) const { return false; }
   //@}
 
+  /// Marks the object as belonging to a frozen game
+  static void FreezeObject(GameObject *p_object) 
+  { if (p_object) p_object->m_frozen = true; }
+
 
 public:
   /// @name Lifecycle
@@ -684,6 +701,19 @@ public:
   virtual Game Copy(void) const = 0;
   //@}
 
+  /// @name Sharing between threads
+  //@{
+  /// Turns the game into an immutable snapshot which several threads
+  /// may read concurrently.  All computed values (such as the reduced
+  /// strategies of a tree) are built now rather than on first use, and
+  /// reference counting is switched off for the game and its objects.
+  /// Profiles, supports and other objects computed from the game are
+  /// not shared; each thread should create its own.  A frozen game
+  /// must not be modified, and cannot be unfrozen.
+  virtual void Freeze(void)
+  { throw UndefinedException("Freezing is not supported for this game representation"); }
+  //@}
+
   /// @name General data access
   //@{
   /// Returns true if the game has a game tree representation
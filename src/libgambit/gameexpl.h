@@ -50,6 +50,11 @@ public:
   virtual ~GameExplicitRep();
   //@}
 
+  /// @name Sharing between threads
+  //@{
+  virtual void Freeze(void);
+  //@}
+
   /// @name General data access
   //@{
   /// Returns the smallest payoff in any outcome of the game
@@ -0,0 +1,431 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/gamegen.cc
+// Generators of random games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cmath>
+#include <climits>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "gamegen.h"
+#include "gametree.h"
+
+namespace Gambit {
+
+//========================================================================
+//                       class GameRandom
+//========================================================================
+
+GameRandom::GameRandom(unsigned long p_seed /*= 1*/)
+  : m_haveNormal(false), m_normal(0.0)
+{
+  // The four words of state are filled from the seed by a linear
+  // congruential generator; xorshift requires they not all be zero,
+  // and the last never is.
+  unsigned long state = p_seed & 0xffffffffUL;
+  unsigned long *words[4] = { &m_x, &m_y, &m_z, &m_w };
+  for (int i = 0; i < 4; i++) {
+    state = (1103515245UL * state + 12345UL) & 0xffffffffUL;
+    *words[i] = state;
+  }
+  m_w |= 1UL;
+}
+
+unsigned long GameRandom::Next(void)
+{
+  unsigned long t = (m_x ^ (m_x << 11)) & 0xffffffffUL;
+  m_x = m_y;
+  m_y = m_z;
+  m_z = m_w;
+  m_w = (m_w ^ (m_w >> 19) ^ t ^ (t >> 8)) & 0xffffffffUL;
+  return m_w;
+}
+
+int GameRandom::NextInt(int p_range)
+{
+  if (p_range <= 0)  throw ValueException();
+  unsigned long range = (unsigned long) p_range;
+  // Draws falling in the incomplete block of p_range values at the
+  // top of the 32-bit range are rejected, so the result is unbiased.
+  unsigned long excess = (0xffffffffUL % range + 1UL) % range;
+  unsigned long value;
+  do {
+    value = Next();
+  } while (excess > 0 && value > 0xffffffffUL - excess);
+  return (int) (value % range);
+}
+
+double GameRandom::NextDouble(void)
+{
+  return (double) Next() / 4294967296.0;
+}
+
+double GameRandom::NextNormal(void)
+{
+  // Box-Muller transform; each pair of uniform draws gives two normal
+  // draws, the second of which is kept for the next call.
+  if (m_haveNormal) {
+    m_haveNormal = false;
+    return m_normal;
+  }
+  double u = 1.0 - NextDouble(), v = NextDouble();
+  double r = std::sqrt(-2.0 * std::log(u));
+  m_normal = r * std::sin(2.0 * M_PI * v);
+  m_haveNormal = true;
+  return r * std::cos(2.0 * M_PI * v);
+}
+
+//========================================================================
+//                     Random strategic games
+//========================================================================
+
+namespace {
+
+/// Returns the number of contingencies of a game with dimensions p_dim,
+/// checking the dimensions are valid and the table can be indexed
+int NumContingencies(const Array<int> &p_dim)
+{
+  if (p_dim.Length() == 0)  throw ValueException();
+  int size = 1;
+  for (int pl = 1; pl <= p_dim.Length(); pl++) {
+    if (p_dim[pl] <= 0 || size > INT_MAX / p_dim[pl]) {
+      throw ValueException();
+    }
+    size *= p_dim[pl];
+  }
+  return size;
+}
+
+/// Advances p_profile to the next contingency, with player 1's strategy
+/// varying fastest, which is the order of the outcomes of a new table
+void NextContingency(Array<int> &p_profile, const Array<int> &p_dim)
+{
+  for (int pl = 1; pl <= p_dim.Length(); pl++) {
+    if (p_profile[pl] < p_dim[pl]) {
+      p_profile[pl]++;
+      return;
+    }
+    p_profile[pl] = 1;
+  }
+}
+
+/// Rounds half away from zero, so that negating a value negates its
+/// rounding
+long Round(double p_value)
+{
+  return (p_value < 0.0) ? -((long) std::floor(-p_value + 0.5)) :
+    (long) std::floor(p_value + 0.5);
+}
+
+void SetPayoff(const GameOutcome &p_outcome, int p_player, long p_payoff)
+{
+  p_outcome->SetPayoff(p_player, lexical_cast<std::string>(p_payoff));
+}
+
+/// Draws payoffs uniformly from 0, ..., p_maxPayoff; if p_zeroSum is set,
+/// the last player's payoff is the negative of the sum of the others'
+void SetRandomPayoffs(const GameOutcome &p_outcome, int p_players,
+		      bool p_zeroSum, GameRandom &p_random, int p_maxPayoff)
+{
+  long total = 0;
+  for (int pl = 1; pl <= p_players; pl++) {
+    long payoff = (p_zeroSum && pl == p_players) ? -total :
+      p_random.NextInt(p_maxPayoff + 1);
+    total += payoff;
+    SetPayoff(p_outcome, pl, payoff);
+  }
+}
+
+Game UniformTableGame(const Array<int> &p_dim, bool p_zeroSum,
+		      GameRandom &p_random, int p_maxPayoff)
+{
+  if (p_maxPayoff < 0)  throw ValueException();
+  int size = NumContingencies(p_dim);
+  Game game = NewTable(p_dim);
+  for (int cont = 1; cont <= size; cont++) {
+    SetRandomPayoffs(game->GetOutcome(cont), p_dim.Length(), p_zeroSum,
+		     p_random, p_maxPayoff);
+  }
+  return game;
+}
+
+}  // end anonymous namespace
+
+Game RandomTableGame(const Array<int> &p_dim, GameRandom &p_random,
+		     int p_maxPayoff /*= 100*/)
+{
+  return UniformTableGame(p_dim, false, p_random, p_maxPayoff);
+}
+
+Game ZeroSumTableGame(const Array<int> &p_dim, GameRandom &p_random,
+		      int p_maxPayoff /*= 100*/)
+{
+  return UniformTableGame(p_dim, true, p_random, p_maxPayoff);
+}
+
+Game CovariantTableGame(const Array<int> &p_dim, double p_covariance,
+			GameRandom &p_random, int p_scale /*= 100*/)
+{
+  int size = NumContingencies(p_dim);
+  int n = p_dim.Length();
+  if (p_covariance > 1.0 ||
+      (n > 1 && p_covariance < -1.0 / (double) (n - 1))) {
+    throw ValueException();
+  }
+
+  // With z_i independent standard normals and zbar their mean, the
+  // payoffs x_i = (z_i - lambda * zbar) / sd have unit variance and
+  // pairwise correlation p_covariance for the lambda below.  At the
+  // lower limit of the correlation, lambda is one, and the payoffs sum
+  // to zero; the last is then set from the others so that they do so
+  // exactly after rounding.
+  bool common = (n == 1 || p_covariance == 1.0), zeroSum = false;
+  double lambda = 0.0, sd = 1.0;
+  if (!common) {
+    double radicand = 1.0 + p_covariance * n / (1.0 - p_covariance);
+    zeroSum = (radicand < 1.0e-12);
+    lambda = (zeroSum) ? 1.0 : 1.0 - std::sqrt(radicand);
+    sd = std::sqrt(1.0 - 2.0 * lambda / n + lambda * lambda / n);
+  }
+
+  Game game = NewTable(p_dim);
+  Array<double> z(n);
+  for (int cont = 1; cont <= size; cont++) {
+    GameOutcome outcome = game->GetOutcome(cont);
+    if (common) {
+      long payoff = Round(p_scale * p_random.NextNormal());
+      for (int pl = 1; pl <= n; pl++) {
+	SetPayoff(outcome, pl, payoff);
+      }
+      continue;
+    }
+    double mean = 0.0;
+    for (int pl = 1; pl <= n; pl++) {
+      z[pl] = p_random.NextNormal();
+      mean += z[pl] / n;
+    }
+    long total = 0;
+    for (int pl = 1; pl <= n; pl++) {
+      long payoff = (zeroSum && pl == n) ? -total :
+	Round(p_scale * (z[pl] - lambda * mean) / sd);
+      total += payoff;
+      SetPayoff(outcome, pl, payoff);
+    }
+  }
+  return game;
+}
+
+Game CoordinationTableGame(const Array<int> &p_dim, GameRandom &p_random,
+			   int p_maxPayoff /*= 100*/)
+{
+  if (p_maxPayoff < 1)  throw ValueException();
+  int size = NumContingencies(p_dim);
+  int n = p_dim.Length();
+  Game game = NewTable(p_dim);
+  Array<int> profile(n);
+  for (int pl = 1; pl <= n; profile[pl++] = 1);
+  for (int cont = 1; cont <= size; cont++) {
+    bool diagonal = true;
+    for (int pl = 2; diagonal && pl <= n; pl++) {
+      diagonal = (profile[pl] == profile[1]);
+    }
+    if (diagonal) {
+      long payoff = 1 + p_random.NextInt(p_maxPayoff);
+      GameOutcome outcome = game->GetOutcome(cont);
+      for (int pl = 1; pl <= n; pl++) {
+	SetPayoff(outcome, pl, payoff);
+      }
+    }
+    NextContingency(profile, p_dim);
+  }
+  return game;
+}
+
+Game CongestionTableGame(int p_players, int p_facilities,
+			 GameRandom &p_random, int p_maxPayoff /*= 100*/)
+{
+  if (p_players <= 0 || p_facilities <= 0 || p_maxPayoff < 0) {
+    throw ValueException();
+  }
+  Array<int> dim(p_players);
+  for (int pl = 1; pl <= p_players; dim[pl++] = p_facilities);
+  int size = NumContingencies(dim);
+
+  // rewards[f][k-1] is the reward of facility f+1 when k players use it
+  std::vector<std::vector<int> > rewards(p_facilities);
+  for (int f = 0; f < p_facilities; f++) {
+    for (int k = 0; k < p_players; k++) {
+      rewards[f].push_back(p_random.NextInt(p_maxPayoff + 1));
+    }
+    std::sort(rewards[f].begin(), rewards[f].end(), std::greater<int>());
+  }
+
+  Game game = NewTable(dim);
+  Array<int> profile(p_players), users(p_facilities);
+  for (int pl = 1; pl <= p_players; profile[pl++] = 1);
+  for (int cont = 1; cont <= size; cont++) {
+    for (int f = 1; f <= p_facilities; users[f++] = 0);
+    for (int pl = 1; pl <= p_players; users[profile[pl++]]++);
+    GameOutcome outcome = game->GetOutcome(cont);
+    for (int pl = 1; pl <= p_players; pl++) {
+      int f = profile[pl];
+      SetPayoff(outcome, pl, rewards[f - 1][users[f] - 1]);
+    }
+    NextContingency(profile, dim);
+  }
+  return game;
+}
+
+Game SparseTableGame(const Array<int> &p_dim, int p_outcomes,
+		     double p_density, GameRandom &p_random,
+		     int p_maxPayoff /*= 100*/)
+{
+  if (p_outcomes <= 0 || p_density < 0.0 || p_density > 1.0 ||
+      p_maxPayoff < 0) {
+    throw ValueException();
+  }
+  NumContingencies(p_dim);
+
+  Game game = NewTable(p_dim, true);
+  for (int outc = 1; outc <= p_outcomes; outc++) {
+    SetRandomPayoffs(game->NewOutcome(), p_dim.Length(), false,
+		     p_random, p_maxPayoff);
+  }
+  for (StrategyProfileIterator iter(game); !iter.AtEnd(); iter++) {
+    if (p_random.NextDouble() < p_density) {
+      (*iter)->SetOutcome(game->GetOutcome(1 + p_random.NextInt(p_outcomes)));
+    }
+  }
+  return game;
+}
+
+//========================================================================
+//                     Random extensive games
+//========================================================================
+
+//
+// Builds the tree depth-first, attaching moves without renumbering the
+// tree after each (as AppendMove() does), and canonicalizes the tree
+// once at the end.  As nodes and information sets are created in the
+// order in which the canonical numbering visits them, the final
+// canonicalization does not need to reorder them, and the whole
+// construction takes time linear in the size of the tree.
+//
+class RandomTreeBuilder {
+private:
+  GameTreeRep *m_efg;
+  int m_depth, m_branching;
+  bool m_perfectInfo, m_zeroSum;
+  GameRandom &m_random;
+  int m_maxPayoff;
+
+  GameTreeInfosetRep *NewInfoset(int p_depth);
+  void SetOutcome(GameTreeNodeRep *p_node);
+  void BuildChildren(GameTreeNodeRep *p_node, int p_depth);
+
+public:
+  RandomTreeBuilder(GameTreeRep *p_efg, int p_depth, int p_branching,
+		    bool p_perfectInfo, bool p_zeroSum,
+		    GameRandom &p_random, int p_maxPayoff)
+    : m_efg(p_efg), m_depth(p_depth), m_branching(p_branching),
+      m_perfectInfo(p_perfectInfo), m_zeroSum(p_zeroSum),
+      m_random(p_random), m_maxPayoff(p_maxPayoff) { }
+
+  void Build(void);
+};
+
+/// Creates a new information set for the player moving at depth p_depth
+GameTreeInfosetRep *RandomTreeBuilder::NewInfoset(int p_depth)
+{
+  GamePlayerRep *player = m_efg->m_players[1 + p_depth % m_efg->m_players.Length()];
+  return new GameTreeInfosetRep(m_efg, player->NumInfosets() + 1,
+				player, m_branching);
+}
+
+void RandomTreeBuilder::SetOutcome(GameTreeNodeRep *p_node)
+{
+  GameOutcome outcome = m_efg->NewOutcome();
+  SetRandomPayoffs(outcome, m_efg->m_players.Length(), m_zeroSum,
+		   m_random, m_maxPayoff);
+  p_node->SetOutcome(outcome);
+}
+
+/// Gives moves (or outcomes) to the children of p_node, which is at
+/// depth p_depth, and recursively to their descendants
+void RandomTreeBuilder::BuildChildren(GameTreeNodeRep *p_node, int p_depth)
+{
+  GameTreeInfosetRep *infoset = 0;
+  for (int i = 1; i <= p_node->children.Length(); i++) {
+    GameTreeNodeRep *child = p_node->children[i];
+    if (p_depth + 1 == m_depth) {
+      SetOutcome(child);
+      continue;
+    }
+    if (!infoset || m_perfectInfo) {
+      infoset = NewInfoset(p_depth + 1);
+    }
+    child->AttachMove(infoset);
+    BuildChildren(child, p_depth + 1);
+  }
+}
+
+void RandomTreeBuilder::Build(void)
+{
+  if (m_depth == 0) {
+    SetOutcome(m_efg->m_root);
+  }
+  else {
+    m_efg->m_root->AttachMove(NewInfoset(0));
+    BuildChildren(m_efg->m_root, 0);
+  }
+  m_efg->ClearComputedValues();
+  m_efg->Canonicalize();
+}
+
+Game RandomTreeGame(int p_players, int p_depth, int p_branching,
+		    bool p_perfectInfo, bool p_zeroSum,
+		    GameRandom &p_random, int p_maxPayoff /*= 100*/)
+{
+  if (p_players <= 0 || p_depth < 0 || p_branching <= 0 ||
+      p_maxPayoff < 0) {
+    throw ValueException();
+  }
+  // Check the nodes can be numbered
+  for (int d = 1, level = 1, total = 1; d <= p_depth; d++) {
+    if (level > INT_MAX / p_branching)  throw ValueException();
+    level *= p_branching;
+    if (total > INT_MAX - level)  throw ValueException();
+    total += level;
+  }
+
+  GameTreeRep *efg = new GameTreeRep();
+  Game game = efg;
+  for (int pl = 1; pl <= p_players; pl++) {
+    game->NewPlayer()->SetLabel(lexical_cast<std::string>(pl));
+  }
+  RandomTreeBuilder(efg, p_depth, p_branching,
+		    p_perfectInfo || p_players == 1, p_zeroSum,
+		    p_random, p_maxPayoff).Build();
+  return game;
+}
+
+}  // end namespace Gambit
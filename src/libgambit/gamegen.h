@@ -0,0 +1,116 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/gamegen.h
+// Generators of random games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_GAMEGEN_H
+#define LIBGAMBIT_GAMEGEN_H
+
+#include "libgambit.h"
+
+namespace Gambit {
+
+///
+/// A portable pseudo-random number generator (Marsaglia's xorshift128).
+/// The sequence drawn from a given seed is the same on every platform
+/// and with every C library, so a game is determined by its generator,
+/// parameters and seed.
+///
+class GameRandom {
+private:
+  unsigned long m_x, m_y, m_z, m_w;
+  bool m_haveNormal;
+  double m_normal;
+
+public:
+  /// Constructs a generator whose sequence is determined by p_seed
+  explicit GameRandom(unsigned long p_seed = 1);
+
+  /// Returns the next 32-bit number in the sequence
+  unsigned long Next(void);
+  /// Returns a number uniformly drawn from 0, ..., p_range - 1
+  int NextInt(int p_range);
+  /// Returns a number uniformly drawn from [0, 1)
+  double NextDouble(void);
+  /// Returns a number drawn from the standard normal distribution
+  double NextNormal(void);
+};
+
+/// @name Random strategic games
+///
+/// The strategic games are generated as tables, with each contingency's
+/// payoffs written as they are drawn; the generators use memory only
+/// in proportion to the number of players beyond that of the table.
+/// Payoffs are integers.
+//@{
+/// A game with payoffs drawn independently and uniformly from
+/// 0, ..., p_maxPayoff
+Game RandomTableGame(const Array<int> &p_dim, GameRandom &p_random,
+		     int p_maxPayoff = 100);
+/// A zero-sum game: payoffs to all players but the last are drawn
+/// uniformly from 0, ..., p_maxPayoff, and the last player's payoff
+/// is the negative of their sum
+Game ZeroSumTableGame(const Array<int> &p_dim, GameRandom &p_random,
+		      int p_maxPayoff = 100);
+/// A game in which the players' payoffs in each contingency are normally
+/// distributed with correlation p_covariance, which must lie in
+/// [-1/(n-1), 1] for n players.  The value 1 gives common payoffs, and
+/// -1 with two players a zero-sum game.  Payoffs are the normal draws
+/// scaled by p_scale and rounded.
+Game CovariantTableGame(const Array<int> &p_dim, double p_covariance,
+			GameRandom &p_random, int p_scale = 100);
+/// A coordination game: in contingencies where every player chooses the
+/// strategy with the same number, all players receive a common payoff
+/// drawn uniformly from 1, ..., p_maxPayoff; elsewhere all receive zero
+Game CoordinationTableGame(const Array<int> &p_dim, GameRandom &p_random,
+			   int p_maxPayoff = 100);
+/// A congestion game with p_players players choosing among p_facilities
+/// facilities.  Each facility has a random reward, nonincreasing in the
+/// number of players using it, of at most p_maxPayoff; a player's payoff
+/// is the reward of the facility chosen given the number choosing it.
+Game CongestionTableGame(int p_players, int p_facilities,
+			 GameRandom &p_random, int p_maxPayoff = 100);
+/// A game with p_outcomes distinct outcomes, with payoffs as for
+/// RandomTableGame().  Each contingency is assigned an outcome drawn
+/// uniformly from these with probability p_density, and otherwise
+/// has no outcome (all payoffs zero).  As outcomes are shared, this
+/// generates games with many more contingencies than the others.
+Game SparseTableGame(const Array<int> &p_dim, int p_outcomes,
+		     double p_density, GameRandom &p_random,
+		     int p_maxPayoff = 100);
+//@}
+
+/// @name Random extensive games
+//@{
+/// A tree of depth p_depth in which every move has p_branching actions,
+/// and the p_players players move in turn.  Unless p_perfectInfo is set,
+/// the children of each node share an information set, so that each
+/// player observes all moves except the one made immediately before;
+/// the game has perfect recall.  A game with one player always has
+/// perfect information.  Payoffs at the terminal nodes are drawn as for
+/// RandomTableGame(), or ZeroSumTableGame() if p_zeroSum is set.
+Game RandomTreeGame(int p_players, int p_depth, int p_branching,
+		    bool p_perfectInfo, bool p_zeroSum,
+		    GameRandom &p_random, int p_maxPayoff = 100);
+//@}
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_GAMEGEN_H
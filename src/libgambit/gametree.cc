@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 
 #include "libgambit.h"
 #include "gametree.h"
@@ -230,7 +231,8 @@ bool GameTreeInfosetRep::IsChanceInfoset(void) const
 //========================================================================
 
 GameTreeNodeRep::GameTreeNodeRep(GameTreeRep *e, GameTreeNodeRep *p)
-  : number(0), m_efg(e), infoset(0), m_parent(p), outcome(0)
+  : number(0), m_efg(e), infoset(0), m_parent(p), outcome(0),
+    m_lastDescendant(0), m_subgameRoot(false)
 { }
 
 GameTreeNodeRep::~GameTreeNodeRep()
@@ -293,37 +295,22 @@ void GameTreeNodeRep::SetOutcome(const GameOutcome &p_outcome)
 
 bool GameTreeNodeRep::IsSuccessorOf(GameNode p_node) const
 {
-  GameTreeNodeRep *n = const_cast<GameTreeNodeRep *>(this);
-  while (n && n != p_node) n = n->m_parent;
-  return (n == p_node);
+  GameTreeNodeRep *node = dynamic_cast<GameTreeNodeRep *>(p_node.operator->());
+  if (!node || node->m_efg != m_efg) {
+    GameTreeNodeRep *n = const_cast<GameTreeNodeRep *>(this);
+    while (n && n != p_node) n = n->m_parent;
+    return (n == p_node);
+  }
+
+  // The subtree rooted at a node is numbered consecutively from it
+  if (!m_efg->m_subgameRootsComputed)  m_efg->BuildSubgameRoots();
+  return (node->number <= number && number <= node->m_lastDescendant);
 }
 
 bool GameTreeNodeRep::IsSubgameRoot(void) const
 {
-  // First take care of a couple easy cases
-  if (children.Length() == 0 || infoset->NumMembers() > 1) return false;
-  if (!m_parent) return true;
-
-  // A node is a subgame root if and only if in every information set,
-  // either all members succeed the node in the tree,
-  // or all members do not succeed the node in the tree.
-  for (int pl = 1; pl <= m_efg->NumPlayers(); pl++) {
-    GamePlayerRep *player = m_efg->GetPlayer(pl);
-    
-    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      GameTreeInfosetRep *infoset = dynamic_cast<GameTreeInfosetRep *>(player->GetInfoset(iset).operator->());
-
-      bool precedes = infoset->GetMember(1)->IsSuccessorOf(const_cast<GameTreeNodeRep *>(this));
-
-      for (int mem = 2; mem <= infoset->NumMembers(); mem++) {
-	if (infoset->GetMember(mem)->IsSuccessorOf(const_cast<GameTreeNodeRep *>(this)) != precedes) {
-	  return false;
-	}
-      }
-    }
-  }
-
-  return true;
+  if (!m_efg->m_subgameRootsComputed)  m_efg->BuildSubgameRoots();
+  return m_subgameRoot;
 }
 
 void GameTreeNodeRep::DeleteParent(void)
@@ -485,16 +472,21 @@ GameInfoset GameTreeNodeRep::AppendMove(GamePlayer p_player, int p_actions)
 				       p_player, p_actions));
 }  
 
+void GameTreeNodeRep::AttachMove(GameTreeInfosetRep *p_infoset)
+{
+  infoset = p_infoset;
+  infoset->AddMember(this);
+  for (int i = 1; i <= infoset->NumActions(); i++) {
+    children.Append(new GameTreeNodeRep(m_efg, this));
+  }
+}
+
 GameInfoset GameTreeNodeRep::AppendMove(GameInfoset p_infoset)
 {
   if (children.Length() > 0) throw UndefinedException();
   if (p_infoset->GetGame() != m_efg) throw MismatchException();
   
-  infoset = dynamic_cast<GameTreeInfosetRep *>(p_infoset.operator->());
-  infoset->AddMember(this);
-  for (int i = 1; i <= p_infoset->NumActions(); i++) {
-    children.Append(new GameTreeNodeRep(m_efg, this));
-  }
+  AttachMove(dynamic_cast<GameTreeInfosetRep *>(p_infoset.operator->()));
 
   m_efg->ClearComputedValues();
   m_efg->Canonicalize();
@@ -550,6 +542,8 @@ GameInfoset GameTreeNodeRep::InsertMove(GameInfoset p_infoset)
 GameTreeRep::GameTreeRep(void)
 {
   m_computedValues = false;
+  m_subgameRootsComputed = false;
+  m_perfectRecallComputed = false;
   m_chance = new GamePlayerRep(this, 0);
   m_root = new GameTreeNodeRep(this, 0);
 }
@@ -570,6 +564,41 @@ Game GameTreeRep::Copy(void) const
 
 Game NewTree(void)  { return new GameTreeRep(); }
 
+//------------------------------------------------------------------------
+//                GameTreeRep: Sharing between threads
+//------------------------------------------------------------------------
+
+void GameTreeRep::Freeze(void)
+{
+  BuildComputedValues();
+  if (!m_subgameRootsComputed)  BuildSubgameRoots();
+  if (!m_perfectRecallComputed)  BuildPerfectRecall();
+
+  Array<GameTreeNodeRep *> stack;
+  stack.Append(m_root);
+  while (stack.Length() > 0) {
+    GameTreeNodeRep *node = stack.Remove(stack.Length());
+    for (int i = 1; i <= node->children.Length(); i++) {
+      stack.Append(node->children[i]);
+    }
+    FreezeObject(node);
+  }
+
+  for (int pl = 0; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = (pl == 0) ? m_chance : m_players[pl];
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      GameTreeInfosetRep *infoset = player->m_infosets[iset];
+      for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+	FreezeObject(infoset->m_actions[act]);
+      }
+      FreezeObject(infoset);
+    }
+  }
+  FreezeObject(m_chance);
+
+  GameExplicitRep::Freeze();
+}
+
 //------------------------------------------------------------------------
 //                 GameTreeRep: General data access
 //------------------------------------------------------------------------
@@ -619,54 +648,12 @@ bool GameTreeRep::IsConstSum(void) const
 
 bool GameTreeRep::IsPerfectRecall(GameInfoset &s1, GameInfoset &s2) const
 {
-  for (int pl = 1; pl <= m_players.Length(); pl++)   {
-    GamePlayerRep *player = m_players[pl];
-    
-    for (int i = 1; i <= player->NumInfosets(); i++)  {
-      GameTreeInfosetRep *iset1 = player->m_infosets[i];
-      for (int j = 1; j <= player->NumInfosets(); j++)   {
-	GameTreeInfosetRep *iset2 = player->m_infosets[j];
-
-	bool precedes = false;
-	int action = 0;
-	
-	for (int m = 1; m <= iset2->NumMembers(); m++)  {
-	  int n;
-	  for (n = 1; n <= iset1->NumMembers(); n++)  {
-	    if (iset2->GetMember(m)->IsSuccessorOf(iset1->GetMember(n)) &&
-	        iset1->GetMember(n) != iset2->GetMember(m))  {
-	      precedes = true;
-	      for (int act = 1; act <= iset1->NumActions(); act++)  {
-		if (iset2->GetMember(m)->IsSuccessorOf(iset1->GetMember(n)->GetChild(act))) {
-		  if (action != 0 && action != act)  {
-		    s1 = iset1;
-		    s2 = iset2;
-		    return false;
-		  }
-		  action = act;
-		}
-	      }
-	      break;
-	    }
-	  }
-	  
-	  if (i == j && precedes)  {
-	    s1 = iset1;
-	    s2 = iset2;
-	    return false;
-	  }
-
-	  if (n > iset1->NumMembers() && precedes)  {
-	    s1 = iset1;
-	    s2 = iset2;
-	    return false;
-	  }
-	}
-      }
-    }
+  if (!m_perfectRecallComputed)  BuildPerfectRecall();
+  if (!m_perfectRecall) {
+    s1 = m_recallInfoset1;
+    s2 = m_recallInfoset2;
   }
-
-  return true;
+  return m_perfectRecall;
 }
 
 
@@ -683,6 +670,8 @@ void GameTreeRep::NumberNodes(GameTreeNodeRep *n, int &index)
 
 void GameTreeRep::Canonicalize(void)
 {
+  m_subgameRootsComputed = false;
+  m_perfectRecallComputed = false;
   int nodeindex = 1;
   NumberNodes(m_root, nodeindex);
 
@@ -690,25 +679,30 @@ void GameTreeRep::Canonicalize(void)
     GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
     
     // Sort nodes within information sets according to ID.
-    // Coded using a bubble sort for simplicity; large games might
-    // find a quicksort worthwhile.
+    // Coded using a bubble sort for simplicity; a pass with no exchanges
+    // ends the sort, so members already in order cost a single pass.
     for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
       GameTreeInfosetRep *infoset = player->m_infosets[iset];
-      for (int i = 1; i < infoset->m_members.Length(); i++) {
+      bool exchanged = true;
+      for (int i = 1; exchanged && i < infoset->m_members.Length(); i++) {
+	exchanged = false;
 	for (int j = 1; j < infoset->m_members.Length() - i; j++) {
 	  if (infoset->m_members[j+1]->number < infoset->m_members[j]->number) {
 	    GameTreeNodeRep *tmp = infoset->m_members[j];
 	    infoset->m_members[j] = infoset->m_members[j+1];
 	    infoset->m_members[j+1] = tmp;
+	    exchanged = true;
 	  }
 	}
       }
     }
 
     // Sort information sets by the smallest ID among their members
-    // Coded using a bubble sort for simplicity; large games might
-    // find a quicksort worthwhile.
-    for (int i = 1; i < player->m_infosets.Length(); i++) {
+    // Coded using a bubble sort for simplicity; as above, information
+    // sets already in order cost a single pass.
+    bool exchanged = true;
+    for (int i = 1; exchanged && i < player->m_infosets.Length(); i++) {
+      exchanged = false;
       for (int j = 1; j < player->m_infosets.Length() - i; j++) {
 	int a = ((player->m_infosets[j+1]->m_members.Length()) ?
 		 player->m_infosets[j+1]->m_members[1]->number : 0);
@@ -719,6 +713,7 @@ void GameTreeRep::Canonicalize(void)
 	  GameTreeInfosetRep *tmp = player->m_infosets[j];
 	  player->m_infosets[j] = player->m_infosets[j+1];
 	  player->m_infosets[j+1] = tmp;
+	  exchanged = true;
 	}
       }
     }
@@ -730,6 +725,129 @@ void GameTreeRep::Canonicalize(void)
   }
 }
 
+//
+// Computes, for the subtree rooted at p_node, the last node number in
+// the subtree, and the smallest and largest node numbers of any member
+// of an information set with a member in the subtree.  On entry, p_lo
+// and p_hi give these bounds for each node's own information set.  A
+// node is the root of a subgame if these bounds lie within its subtree,
+// since the subtree is numbered consecutively.
+//
+void GameTreeRep::MarkSubgameRoots(GameTreeNodeRep *p_node,
+				   std::vector<int> &p_lo,
+				   std::vector<int> &p_hi) const
+{
+  int n = p_node->number;
+  p_node->m_lastDescendant = n;
+  for (int i = 1; i <= p_node->children.Length(); i++) {
+    GameTreeNodeRep *child = p_node->children[i];
+    MarkSubgameRoots(child, p_lo, p_hi);
+    p_node->m_lastDescendant = child->m_lastDescendant;
+    p_lo[n] = std::min(p_lo[n], p_lo[child->number]);
+    p_hi[n] = std::max(p_hi[n], p_hi[child->number]);
+  }
+
+  // Terminal nodes, and members of information sets with several
+  // members, are never subgame roots
+  p_node->m_subgameRoot = (p_node->children.Length() > 0 &&
+			   p_node->infoset->m_members.Length() == 1 &&
+			   (!p_node->m_parent ||
+			    (p_lo[n] >= n && p_hi[n] <= p_node->m_lastDescendant)));
+}
+
+void GameTreeRep::BuildSubgameRoots(void) const
+{
+  int numNodes = NumNodes();
+  std::vector<int> lo(numNodes + 1), hi(numNodes + 1);
+  for (int n = 1; n <= numNodes; n++) {
+    lo[n] = hi[n] = n;
+  }
+  // Chance information sets are not required to respect subgames
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = m_players[pl];
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      const Array<GameTreeNodeRep *> &members = player->m_infosets[iset]->m_members;
+      int first = numNodes, last = 1;
+      for (int m = 1; m <= members.Length(); m++) {
+	first = std::min(first, members[m]->number);
+	last = std::max(last, members[m]->number);
+      }
+      for (int m = 1; m <= members.Length(); m++) {
+	lo[members[m]->number] = first;
+	hi[members[m]->number] = last;
+      }
+    }
+  }
+  MarkSubgameRoots(m_root, lo, hi);
+  m_subgameRootsComputed = true;
+}
+
+//
+// Visits the subtree rooted at p_node, where p_last gives for each player
+// the last action taken by that player on the path to p_node, if any.
+// A game has perfect recall exactly when, for every information set,
+// the player's last action before reaching it is the same at all of its
+// members: by induction, the whole sequence of the player's information
+// sets and actions is then the same.  p_first records this action for
+// each information set at the first member reached, as flagged in
+// p_seen.  Returns false, recording the offending information sets,
+// at the first violation.
+//
+bool GameTreeRep::CheckPerfectRecall(GameTreeNodeRep *p_node,
+				     std::vector<GameTreeActionRep *> &p_last,
+				     std::vector<std::vector<GameTreeActionRep *> > &p_first,
+				     std::vector<std::vector<bool> > &p_seen) const
+{
+  GameTreeInfosetRep *infoset = p_node->infoset;
+  if (!infoset) {
+    return true;
+  }
+  if (infoset->GetPlayer()->IsChance()) {
+    for (int i = 1; i <= p_node->children.Length(); i++) {
+      if (!CheckPerfectRecall(p_node->children[i], p_last, p_first, p_seen)) {
+	return false;
+      }
+    }
+    return true;
+  }
+
+  int pl = infoset->GetPlayer()->GetNumber(), iset = infoset->GetNumber();
+  GameTreeActionRep *last = p_last[pl];
+  if (!p_seen[pl][iset]) {
+    p_seen[pl][iset] = true;
+    p_first[pl][iset] = last;
+  }
+  else if (p_first[pl][iset] != last) {
+    m_recallInfoset1 = (p_first[pl][iset]) ? p_first[pl][iset]->m_infoset : last->m_infoset;
+    m_recallInfoset2 = infoset;
+    return false;
+  }
+
+  for (int i = 1; i <= p_node->children.Length(); i++) {
+    p_last[pl] = infoset->m_actions[i];
+    if (!CheckPerfectRecall(p_node->children[i], p_last, p_first, p_seen)) {
+      return false;
+    }
+  }
+  p_last[pl] = last;
+  return true;
+}
+
+void GameTreeRep::BuildPerfectRecall(void) const
+{
+  std::vector<GameTreeActionRep *> last(m_players.Length() + 1, (GameTreeActionRep *) 0);
+  std::vector<std::vector<GameTreeActionRep *> > first(m_players.Length() + 1);
+  std::vector<std::vector<bool> > seen(m_players.Length() + 1);
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    first[pl].resize(m_players[pl]->m_infosets.Length() + 1, (GameTreeActionRep *) 0);
+    seen[pl].resize(m_players[pl]->m_infosets.Length() + 1, false);
+  }
+
+  m_recallInfoset1 = m_recallInfoset2 = 0;
+  m_perfectRecall = CheckPerfectRecall(m_root, last, first, seen);
+  m_perfectRecallComputed = true;
+}
+
 void GameTreeRep::ClearComputedValues(void) const
 {
   for (int pl = 1; pl <= m_players.Length(); pl++) {
@@ -746,6 +864,7 @@ void GameTreeRep::BuildComputedValues(void)
   if (m_computedValues) return;
 
   Canonicalize();
+  BuildSubgameRoots();
 
   for (int pl = 1; pl <= m_players.Length(); pl++) {
     m_players[pl]->MakeReducedStrats(m_root, 0);
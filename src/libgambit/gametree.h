@@ -23,11 +23,13 @@
 #ifndef GAMETREE_H
 #define GAMETREE_H
 
+#include <vector>
 #include "gameexpl.h"
 
 namespace Gambit {
 
 class GameTreeRep;
+class RandomTreeBuilder;
 
 class GameTreeActionRep : public GameActionRep {
   friend class GameTreeRep;
@@ -61,6 +63,7 @@ class GameTreeInfosetRep : public GameInfosetRep {
   friend class GameTreeActionRep;
   friend class GamePlayerRep;
   friend class GameTreeNodeRep;
+  friend class RandomTreeBuilder;
   template <class T> friend class MixedBehaviorProfile;
 
 protected:
@@ -132,6 +135,7 @@ class GameTreeNodeRep : public GameNodeRep {
   friend class GameTreeInfosetRep;
   friend class GamePlayerRep;
   friend class PureBehaviorProfile;
+  friend class RandomTreeBuilder;
   template <class T> friend class MixedBehaviorProfile;
   
 protected:
@@ -143,6 +147,10 @@ protected:
   GameOutcomeRep *outcome;
   Array<GameTreeNodeRep *> children;
   GameTreeNodeRep *whichbranch, *ptr;
+  /// The highest number of a node in the subtree rooted here; the
+  /// subtree's nodes are numbered consecutively from this node's number
+  int m_lastDescendant;
+  bool m_subgameRoot;
 
   GameTreeNodeRep(GameTreeRep *e, GameTreeNodeRep *p);
   virtual ~GameTreeNodeRep();
@@ -150,6 +158,11 @@ protected:
   void DeleteOutcome(GameOutcomeRep *outc);
   void CopySubtree(GameTreeNodeRep *, GameTreeNodeRep *);
 
+  /// Places this terminal node in the information set, and creates its
+  /// children, without renumbering the tree.  Builders adding many moves
+  /// use this, and canonicalize the tree once at the end.
+  void AttachMove(GameTreeInfosetRep *p_infoset);
+
 public:
   virtual Game GetGame(void) const; 
 
@@ -200,19 +213,34 @@ class GameTreeRep : public GameExplicitRep {
   friend class GameTreeNodeRep;
   friend class GameTreeInfosetRep;
   friend class GameTreeActionRep;
+  friend class RandomTreeBuilder;
 protected:
-  mutable bool m_computedValues;
+  mutable bool m_computedValues, m_subgameRootsComputed;
+  mutable bool m_perfectRecallComputed, m_perfectRecall;
+  /// Information sets violating perfect recall, if any
+  mutable GameTreeInfosetRep *m_recallInfoset1, *m_recallInfoset2;
   GameTreeNodeRep *m_root;
   GamePlayerRep *m_chance;
 
   /// @name Private auxiliary functions
   //@{
   void NumberNodes(GameTreeNodeRep *, int &);
+  void MarkSubgameRoots(GameTreeNodeRep *, std::vector<int> &,
+			std::vector<int> &) const;
+  bool CheckPerfectRecall(GameTreeNodeRep *, 
+			  std::vector<GameTreeActionRep *> &,
+			  std::vector<std::vector<GameTreeActionRep *> > &,
+			  std::vector<std::vector<bool> > &) const;
   //@}
 
   /// @name Managing the representation
   //@{
   virtual void Canonicalize(void);
+  /// Computes the extent of each node's subtree, and which nodes are
+  /// roots of subgames, for the current numbering of the nodes
+  void BuildSubgameRoots(void) const;
+  /// Determines whether the game has perfect recall
+  void BuildPerfectRecall(void) const;
   virtual void BuildComputedValues(void);
   virtual void ClearComputedValues(void) const;
   /// Have computed values been built?
@@ -227,6 +255,11 @@ public:
   virtual Game Copy(void) const;
   //@}
 
+  /// @name Sharing between threads
+  //@{
+  virtual void Freeze(void);
+  //@}
+
   /// @name General data access
   //@{
   virtual bool IsTree(void) const { return true; }
@@ -43,6 +43,7 @@ Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 #include <cmath>
 #include <cstring>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 
 namespace Gambit {
 
@@ -189,6 +190,10 @@ static IntegerRep* Inew(int newlen)
     
   IntegerRep* rep = (IntegerRep *) new char[allocsiz];
   rep->sz = (allocsiz - sizeof(IntegerRep) + sizeof(short)) / sizeof(short);
+  Gambit::Statistics::Count(Gambit::Statistics::IntegerAllocations);
+  if ((unsigned) newlen > SHORT_PER_LONG) {
+    Gambit::Statistics::Count(Gambit::Statistics::BignumPromotions);
+  }
   return rep;
 }
 
@@ -66,7 +66,7 @@ public:
   public:
     iterator(const List &p_list, Node *p_node)
       : m_list(p_list), m_node(p_node)  { }
-    T &operator*(void) const { return *m_node; }
+    T &operator*(void) const { return m_node->m_data; }
     iterator &operator++(void)  { m_node = m_node->m_next; return *this; }
     bool operator==(const iterator &it) const
     { return (m_node == it.m_node); }
@@ -81,7 +81,7 @@ public:
   public:
     const_iterator(const List &p_list, Node *p_node)
       : m_list(p_list), m_node(p_node)  { }
-    const T &operator*(void) const { return *m_node; }
+    const T &operator*(void) const { return m_node->m_data; }
     const_iterator &operator++(void)  { m_node = m_node->m_next; return *this; }
     bool operator==(const const_iterator &it) const
     { return (m_node == it.m_node); }
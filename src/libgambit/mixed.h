@@ -24,6 +24,7 @@
 #define LIBGAMBIT_MIXED_H
 
 #include "vector.h"
+#include "matrix.h"
 #include "gameagg.h"
 #include "gamebagg.h"
 
@@ -52,6 +53,7 @@ public:
   virtual T GetPayoff(int pl) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const = 0;
+  virtual void GetPayoffHessian(int pl, Matrix<T> &) const;
 };
 
 template <class T> class TreeMixedStrategyProfileRep 
@@ -94,6 +96,7 @@ public:
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual void GetPayoffHessian(int pl, Matrix<T> &) const;
 };
 
 template <class T> class AggMixedStrategyProfileRep
@@ -249,6 +252,17 @@ public:
   T GetPayoffDeriv(int pl, const GameStrategy &s1, const GameStrategy &s2) const
   { return m_rep->GetPayoffDeriv(pl, s1, s2); }
 
+  /// \brief Computes all second derivatives of the player's payoff
+  ///
+  /// Computes the second derivatives of the payoff to the player with
+  /// respect to the probabilities of each pair of strategies, indexed
+  /// by position in the profile.  The matrix must be square, with
+  /// MixedProfileLength() rows.  Entries for two strategies of the same
+  /// player are zero.  For strategic games, this is computed in a single
+  /// pass over the table, rather than one pass per pair of strategies.
+  void GetPayoffHessian(int pl, Matrix<T> &p_hessian) const
+  { m_rep->GetPayoffHessian(pl, p_hessian); }
+
   /// Computes the payoff to playing the pure strategy against the profile
   T GetPayoff(const GameStrategy &p_strategy) const
   { return GetPayoffDeriv(p_strategy->GetPlayer()->GetNumber(), p_strategy); }
@@ -20,7 +20,13 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
+#include <map>
+#include <set>
 #include "nash.h"
+#if defined(HAVE_PTHREAD_H)
+#include <pthread.h>
+#endif  // HAVE_PTHREAD_H
 
 namespace Gambit {
 
@@ -217,8 +223,11 @@ NashBehavViaStrategySolver<T>::Solve(const BehaviorSupportProfile &p_support) co
 
 template <class T>
 SubgameNashBehavSolver<T>::SubgameNashBehavSolver(shared_ptr<NashBehavSolver<T> > p_solver,
-						  shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */)
-  : NashBehavSolver<T>(p_onEquilibrium), m_solver(p_solver)
+						  shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */,
+						  int p_numThreads /* = 1 */,
+						  int p_maxCombinations /* = 0 */)
+  : NashBehavSolver<T>(p_onEquilibrium), m_solver(p_solver),
+    m_numThreads(p_numThreads), m_maxCombinations(p_maxCombinations)
 { }
 
 // A nested anonymous namespace to privatize these functions 
@@ -240,175 +249,465 @@ void ChildSubgames(const GameNode &p_node, List<GameNode> &p_list)
   }
 }
 
+///
+/// Numbers the information sets of each player in the subtree rooted
+/// at 'p_node' in the order in which they are first reached in a
+/// preorder traversal.  Information sets are identified by their
+/// labels, which are set to unique IDs before solving.
+///
+void NumberInfosets(const GameNode &p_node, Array<std::map<int, int> > &p_numbers)
+{
+  GameInfoset infoset = p_node->GetInfoset();
+  if (infoset && !infoset->GetPlayer()->IsChance()) {
+    std::map<int, int> &numbers = p_numbers[infoset->GetPlayer()->GetNumber()];
+    int id = atoi(infoset->GetLabel().c_str());
+    if (numbers.count(id) == 0) {
+      int number = numbers.size() + 1;
+      numbers[id] = number;
+    }
+  }
+  for (int i = 1; i <= p_node->NumChildren(); 
+       NumberInfosets(p_node->GetChild(i++), p_numbers));
+}
+
+///
+/// The information sets of one occurrence of a subgame, excluding
+/// those in its proper subgames.  For each player, the IDs of the
+/// information sets are listed in the order numbered by NumberInfosets().
+///
+class SubgameLayout {
+public:
+  Array<Array<int> > infosets;
+  Array<shared_ptr<SubgameLayout> > children;
+
+  SubgameLayout(int p_numPlayers) : infosets(p_numPlayers) { }
+};
+
+///
+/// Sorts subgames into classes, such that two subgames are in the same
+/// class when copies of them are identical apart from labels.  This
+/// holds when they have the same shape, the same players and
+/// information set structure, the same chance probabilities and the
+/// same payoffs, with outcomes shared among nodes in the same way.
+///
+class SubgameClassifier {
+private:
+  std::map<std::string, int> m_classes;
+
+  void Visit(const GameNode &p_node, const GameNode &p_root,
+	     std::ostringstream &p_key, SubgameLayout &p_layout,
+	     std::map<GameInfosetRep *, int> &p_infosets,
+	     std::map<GameOutcomeRep *, int> &p_outcomes);
+
+public:
+  /// Sets the label of the root of each subgame in the subtree rooted
+  /// at p_root, including p_root itself, to the number of its class,
+  /// and returns the layout of the subgame rooted at p_root
+  shared_ptr<SubgameLayout> Classify(const GameNode &p_root);
+};
+
+shared_ptr<SubgameLayout> SubgameClassifier::Classify(const GameNode &p_root)
+{
+  shared_ptr<SubgameLayout> layout(new SubgameLayout(p_root->GetGame()->NumPlayers()));
+  std::ostringstream key;
+  std::map<GameInfosetRep *, int> infosets;
+  std::map<GameOutcomeRep *, int> outcomes;
+  Visit(p_root, p_root, key, *layout, infosets, outcomes);
+
+  std::map<std::string, int>::iterator entry = m_classes.find(key.str());
+  if (entry == m_classes.end()) {
+    entry = m_classes.insert(std::make_pair(key.str(), 
+					    (int) m_classes.size() + 1)).first;
+  }
+  p_root->SetLabel(lexical_cast<std::string>(entry->second));
+  return layout;
+}
+
+void SubgameClassifier::Visit(const GameNode &p_node, const GameNode &p_root,
+			      std::ostringstream &p_key, SubgameLayout &p_layout,
+			      std::map<GameInfosetRep *, int> &p_infosets,
+			      std::map<GameOutcomeRep *, int> &p_outcomes)
+{
+  if (p_node != p_root && p_node->IsSubgameRoot()) {
+    p_layout.children.Append(Classify(p_node));
+    p_key << "s" << p_node->GetLabel() << ' ';
+    return;
+  }
+
+  GameOutcome outcome = p_node->GetOutcome();
+  if (!outcome) {
+    p_key << "o0 ";
+  }
+  else if (p_outcomes.count(outcome.operator->())) {
+    p_key << 'o' << p_outcomes[outcome.operator->()] << ' ';
+  }
+  else {
+    int number = p_outcomes.size() + 1;
+    p_outcomes[outcome.operator->()] = number;
+    p_key << 'o' << number << '{';
+    for (int pl = 1; pl <= p_node->GetGame()->NumPlayers(); pl++) {
+      p_key << outcome->GetPayoff<std::string>(pl) << ' ';
+    }
+    p_key << "} ";
+  }
+
+  GameInfoset infoset = p_node->GetInfoset();
+  if (!infoset) {
+    p_key << "t ";
+    return;
+  }
+
+  GamePlayer player = infoset->GetPlayer();
+  p_key << ((player->IsChance()) ? 'c' : 'p') << player->GetNumber() << ':';
+  if (p_infosets.count(infoset.operator->())) {
+    p_key << p_infosets[infoset.operator->()] << ' ';
+  }
+  else {
+    int number = p_infosets.size() + 1;
+    p_infosets[infoset.operator->()] = number;
+    p_key << number << '[' << infoset->NumActions();
+    if (player->IsChance()) {
+      for (int act = 1; act <= infoset->NumActions(); act++) {
+	p_key << ' ' << infoset->GetActionProb(act, std::string());
+      }
+    }
+    else {
+      p_layout.infosets[player->GetNumber()].Append(atoi(infoset->GetLabel().c_str()));
+    }
+    p_key << "] ";
+  }
+
+  for (int i = 1; i <= p_node->NumChildren(); i++) {
+    Visit(p_node->GetChild(i), p_root, p_key, p_layout, p_infosets, p_outcomes);
+  }
+}
+
 } // end nested anonymous namespace
 
 //
 // Some general notes on the strategy for solving by subgames:
 //
 // * We work with a *copy* of the original game, which is destroyed
-//   as we go.
+//   as we go.  Each proper subgame is in turn copied out into a game
+//   of its own, so that sibling subgames share no data and can be
+//   solved concurrently.  Copies are made by the thread which owns
+//   the game being copied, as reference counts are not synchronized.
 // * Before solving, information set labels on the copy game are
-//   set to unique IDs.  These are used to match up information
-//   sets in the subgames (which are themselves copies) to the
-//   original game.
-// * We only carry around DVectors instead of full MixedBehaviorProfiles,
-//   because MixedBehaviorProfiles allocate space several times the
-//   size of the tree to carry around useful quantities.  These
-//   quantities are irrelevant for this calculation, so we only
-//   store the probabilities, and convert to MixedBehaviorProfiles
-//   at the end of the computation
+//   set to unique IDs, and the root of each subgame is labeled with
+//   its class under SubgameClassifier.  Subgames in the same class
+//   have the same equilibria, so each class is solved only once; the
+//   equilibria are kept in a memo by class.
+// * An equilibrium of a subgame is stored as a SubgameSolution,
+//   which records only the probabilities of actions at information
+//   sets which are not in any proper subgame, together with shared
+//   pointers to the equilibria chosen in the proper subgames.
+//   Information sets are identified by their number within the
+//   subgame, so the same solution serves every subgame in a class;
+//   the layout of each occurrence maps these back to the original
+//   game.  We convert to MixedBehaviorProfiles only at the end of the
+//   computation, as MixedBehaviorProfiles allocate space several
+//   times the size of the tree.
+// * Combinations of equilibria of the proper subgames are visited in
+//   turn, with the last subgame varying fastest, rather than
+//   being built up as a list beforehand.
+// * Solutions are shared among subgames, and so are only ever
+//   referenced by one thread at a time: threads solving sibling
+//   subgames keep memos of their own, which are merged into their
+//   parent's once they finish.
+//
+
+template <class T> class SubgameNashBehavSolver<T>::SubgameSolution {
+public:
+  class Entry {
+  public:
+    int player, infoset, action;
+    T prob;
+  };
+
+  List<Entry> entries;
+  Array<shared_ptr<SubgameSolution> > children;
+  Vector<T> value;
+
+  SubgameSolution(int p_numChildren, int p_numPlayers)
+    : children(p_numChildren), value(p_numPlayers) { }
+
+  // Writes the probabilities of this solution and of the solutions
+  // of its proper subgames into p_profile, for the occurrence of the
+  // subgame with layout p_layout
+  void Flatten(const SubgameLayout &p_layout, DVector<T> &p_profile) const
+  {
+    List<const SubgameSolution *> solutions;
+    List<const SubgameLayout *> layouts;
+    solutions.Append(this);
+    layouts.Append(&p_layout);
+    while (solutions.Length() > 0) {
+      const SubgameSolution *solution = solutions.Remove(solutions.Length());
+      const SubgameLayout *layout = layouts.Remove(layouts.Length());
+      for (typename List<Entry>::const_iterator entry = solution->entries.begin();
+	   entry != solution->entries.end(); ++entry) {
+	p_profile((*entry).player,
+		  layout->infosets[(*entry).player][(*entry).infoset],
+		  (*entry).action) = (*entry).prob;
+      }
+      for (int i = 1; i <= solution->children.Length(); i++) {
+	solutions.Append(solution->children[i].get());
+	layouts.Append(layout->children[i].get());
+      }
+    }
+  }
+};
+
+//
+// A proper subgame to be solved, copied out as a game of its own
+//
+template <class T> class SubgameNashBehavSolver<T>::SubgameTask {
+public:
+  Game game;
+  int numThreads;
+  SubgameMemo *memo, ownMemo;
+  List<shared_ptr<SubgameSolution> > solutions;
+
+  SubgameTask(const Game &p_game, int p_numThreads, SubgameMemo *p_memo)
+    : game(p_game), numThreads(p_numThreads), 
+      memo((p_memo) ? p_memo : &ownMemo) { }
+};
+
+//
+// The tasks shared by the worker threads, which claim them in order
 //
+template <class T> class SubgameNashBehavSolver<T>::SubgamePool {
+public:
+  const SubgameNashBehavSolver<T> *owner;
+  Array<SubgameTask *> tasks;
+  int next;
+  std::string error;
+#if defined(HAVE_PTHREAD_H)
+  pthread_mutex_t mutex;
+#endif  // HAVE_PTHREAD_H
+
+  SubgamePool(const SubgameNashBehavSolver<T> *p_owner,
+	      const Array<SubgameTask *> &p_tasks)
+    : owner(p_owner), tasks(p_tasks), next(1)
+  {
+#if defined(HAVE_PTHREAD_H)
+    pthread_mutex_init(&mutex, 0);
+#endif  // HAVE_PTHREAD_H
+  }
+  ~SubgamePool()
+  {
+#if defined(HAVE_PTHREAD_H)
+    pthread_mutex_destroy(&mutex);
+#endif  // HAVE_PTHREAD_H
+  }
+
+  // Returns the next task to be run, or null when all have been claimed
+  SubgameTask *NextTask(void)
+  {
+#if defined(HAVE_PTHREAD_H)
+    pthread_mutex_lock(&mutex);
+#endif  // HAVE_PTHREAD_H
+    SubgameTask *task = (next <= tasks.Length() && error.empty()) ? tasks[next++] : 0;
+#if defined(HAVE_PTHREAD_H)
+    pthread_mutex_unlock(&mutex);
+#endif  // HAVE_PTHREAD_H
+    return task;
+  }
+
+  void SetError(const std::string &p_error)
+  {
+#if defined(HAVE_PTHREAD_H)
+    pthread_mutex_lock(&mutex);
+#endif  // HAVE_PTHREAD_H
+    if (error.empty()) {
+      error = p_error;
+    }
+#if defined(HAVE_PTHREAD_H)
+    pthread_mutex_unlock(&mutex);
+#endif  // HAVE_PTHREAD_H
+  }
+};
+
+template <class T>
+void *SubgameNashBehavSolver<T>::RunTasks(void *p_pool)
+{
+  SubgamePool *pool = static_cast<SubgamePool *>(p_pool);
+  for (SubgameTask *task = pool->NextTask(); task; task = pool->NextTask()) {
+    try {
+      pool->owner->SolveSubgame(task->game, task->numThreads, 
+				*task->memo, task->solutions);
+    }
+    catch (std::exception &e) {
+      pool->SetError(e.what());
+    }
+  }
+  return 0;
+}
 
+//
+// Computes the equilibria of p_subgame, whose root is the root of
+// the subgame.  The game is modified in the process.
+//
 template <class T>
-void SubgameNashBehavSolver<T>::SolveSubgames(const BehaviorSupportProfile &p_support,
-					      const DVector<T> &p_templateSolution,
-					      GameNode n,
-					      List<DVector<T> > &solns,
-					      List<GameOutcome> &values) const
+void SubgameNashBehavSolver<T>::SolveSubgame(const Game &p_subgame,
+					     int p_numThreads,
+					     SubgameMemo &p_memo,
+					     List<shared_ptr<SubgameSolution> > &p_solutions) const
 {
-  Game efg = p_support.GetGame();
-  
-  List<DVector<T> > thissolns;
-  thissolns.Append(p_templateSolution);
-  ((Vector<T> &) thissolns[1]).operator=(T(0));
-  
+  GameNode root = p_subgame->GetRoot();
+
   List<GameNode> subroots;
-  for (int i = 1; i <= n->NumChildren(); i++) {
-    ChildSubgames(n->GetChild(i), subroots);
-  }
-  
-  List<Array<GameOutcome> > subrootvalues;
-  subrootvalues.Append(Array<GameOutcome>(subroots.Length()));
-  
-  for (int i = 1; i <= subroots.Length(); i++)  {
-    //printf("Looking at subgame %d of %d\n", i, subroots.Length());
-    List<DVector<T> > subsolns;
-    List<GameOutcome> subvalues;
-    
-    SolveSubgames(p_support, p_templateSolution,
-		  subroots[i], subsolns, subvalues);
-    
-    if (subsolns.Length() == 0)  {
-      solns = List<DVector<T> >();
-      return;
+  for (int i = 1; i <= root->NumChildren(); i++) {
+    ChildSubgames(root->GetChild(i), subroots);
+  }
+
+  // Only the first subgame of each class not already in the memo
+  // is solved
+  Array<int> classes(subroots.Length());
+  List<int> unsolved;
+  std::set<int> queued;
+  for (int i = 1; i <= subroots.Length(); i++) {
+    classes[i] = atoi(subroots[i]->GetLabel().c_str());
+    if (p_memo.count(classes[i]) == 0 && queued.count(classes[i]) == 0) {
+      unsolved.Append(i);
+      queued.insert(classes[i]);
     }
+  }
 
-    //printf("Found %d subsolutions for subgame %d of %d\n", 
-    //subsolns.Length(), i, subroots.Length());
-    
-    List<DVector<T> > newsolns;
-    List<Array<GameOutcome> > newsubrootvalues;
-    
-    //printf("Merging with %d existing solutions\n", thissolns.Length());
-    for (int soln = 1; soln <= thissolns.Length(); soln++) {
-      for (int subsoln = 1; subsoln <= subsolns.Length(); subsoln++) {
-	//printf("Merging existing %d with new %d\n", soln, subsoln);
-	DVector<T> bp(thissolns[soln]);
-	DVector<T> tmp(subsolns[subsoln]);
-	for (int j = 1; j <= bp.Length(); j++) {
-	  bp[j] += tmp[j];
-	}
-	newsolns.Append(bp);
-	
-	newsubrootvalues.Append(subrootvalues[soln]);
-	newsubrootvalues[newsubrootvalues.Length()][i] = subvalues[subsoln];
+  // Threads are only started at the shallowest level with more than
+  // one subgame to solve; deeper levels are solved by the thread
+  // which claims them
+  int numThreads = std::max(std::min(p_numThreads, unsolved.Length()) - 1, 0);
+  Array<SubgameTask *> tasks(unsolved.Length());
+  for (int i = 1; i <= unsolved.Length(); i++) {
+    tasks[i] = new SubgameTask(subroots[unsolved[i]]->CopySubgame(),
+			       (unsolved.Length() > 1) ? 1 : p_numThreads,
+			       (numThreads > 0) ? 0 : &p_memo);
+  }
+
+  SubgamePool pool(this, tasks);
+#if defined(HAVE_PTHREAD_H)
+  // This thread works through the tasks alongside the others
+  Array<pthread_t> threads(numThreads);
+  Array<bool> started(numThreads);
+  for (int i = 1; i <= numThreads; i++) {
+    started[i] = (pthread_create(&threads[i], 0, RunTasks, &pool) == 0);
+  }
+  RunTasks(&pool);
+  for (int i = 1; i <= numThreads; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], 0);
+    }
+  }
+#else
+  RunTasks(&pool);
+#endif  // HAVE_PTHREAD_H
+
+  for (int i = 1; i <= tasks.Length(); i++) {
+    if (pool.error.empty()) {
+      if (tasks[i]->memo == &tasks[i]->ownMemo) {
+	p_memo.insert(tasks[i]->ownMemo.begin(), tasks[i]->ownMemo.end());
       }
+      p_memo[classes[unsolved[i]]] = tasks[i]->solutions;
     }
-    
-    thissolns = newsolns;
-    subrootvalues = newsubrootvalues;
-    //printf("Finished solving subgame %d\n", i);
+    delete tasks[i];
   }
-  
-  for (int soln = 1; soln <= thissolns.Length(); soln++)   {
-    //printf("Analyzing scenario %d of %d\n", soln, thissolns.Length());
-    for (int i = 1; i <= subroots.Length(); i++) {
-      subroots[i]->SetOutcome(subrootvalues[soln][i]);
+  if (!pool.error.empty()) {
+    throw Exception(pool.error);
+  }
+
+  Array<List<shared_ptr<SubgameSolution> > > subsolns(subroots.Length());
+  for (int i = 1; i <= subroots.Length(); i++) {
+    subsolns[i] = p_memo[classes[i]];
+    if (subsolns[i].Length() == 0) {
+      return;
     }
-    
-    Game subgame = n->CopySubgame();
-    // this prevents double-counting of outcomes at roots of subgames
-    // by convention, we will just put the payoffs in the parent subgame
-    subgame->GetRoot()->SetOutcome(0);
-
-    BehaviorSupportProfile subsupport(subgame);
-    // Here, we build the support for the subgame
-    /*
-    for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-      GamePlayer subplayer = subgame->GetPlayer(pl);
-      GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-
-      for (int iset = 1; iset <= subplayer->NumInfosets(); iset++) {
-	GameInfoset subinfoset = subplayer->GetInfoset(iset);
-
-	for (int j = 1; j <= player->NumInfosets(); j++) {
-	  GameInfoset infoset = player->GetInfoset(j);
-	  if (subinfoset->GetLabel() == infoset->GetLabel()) {
-	    for (int act = 1; act <= infoset->NumActions(); act++)  {
-	      if (!p_support.Contains(infoset->GetAction(act))) {
-		subsupport.RemoveAction(subinfoset->GetAction(act));
-	      }
-	    }
-	    break;
-	  }
-	}
+  }
+
+  // Each proper subgame is replaced by a terminal node, with an
+  // outcome giving the value of the subgame in each of its equilibria
+  Array<Array<GameOutcome> > subvalues(subroots.Length());
+  for (int i = 1; i <= subroots.Length(); i++) {
+    subroots[i]->DeleteTree();
+    subvalues[i] = Array<GameOutcome>(subsolns[i].Length());
+    for (int j = 1; j <= subsolns[i].Length(); j++) {
+      GameOutcome ov = p_subgame->NewOutcome();
+      for (int pl = 1; pl <= p_subgame->NumPlayers(); pl++) {
+	ov->SetPayoff(pl, lexical_cast<std::string>(subsolns[i][j]->value[pl]));
       }
+      subvalues[i][j] = ov;
+    }
+  }
+
+  // this prevents double-counting of outcomes at roots of subgames
+  // by convention, we will just put the payoffs in the parent subgame
+  GameOutcome outcome = root->GetOutcome();
+  root->SetOutcome(0);
+
+  List<shared_ptr<SubgameSolution> > solns;
+  Array<int> choice(subroots.Length());
+  for (int i = 1; i <= choice.Length(); i++) {
+    choice[i] = 1;
+  }
+  for (int combination = 1; 
+       m_maxCombinations <= 0 || combination <= m_maxCombinations;
+       combination++) {
+    for (int i = 1; i <= subroots.Length(); i++) {
+      subroots[i]->SetOutcome(subvalues[i][choice[i]]);
     }
-    */
 
+    // The stage game is solved as a fresh copy, as some solvers' choices
+    // among equivalent solutions depend on how the game was built
+    Game stage = root->CopySubgame();
+    BehaviorSupportProfile subsupport(stage);
     List<MixedBehaviorProfile<T> > sol = m_solver->Solve(subsupport);
-    
-    if (sol.Length() == 0)  {
-      solns = List<DVector<T> >();
-      //printf("No solutions found\n");
+    if (sol.Length() == 0) {
       return;
     }
-    
-    // Put behavior profile in "total" solution here...
-    for (int solno = 1; solno <= sol.Length(); solno++)  {
-      solns.Append(thissolns[soln]);
-      
-      for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-	GamePlayer subplayer = subgame->GetPlayer(pl);
-	GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-
-	for (int iset = 1; iset <= subplayer->NumInfosets(); iset++) {
-	  GameInfoset subinfoset = subplayer->GetInfoset(iset);
-
-	  for (int j = 1; j <= player->NumInfosets(); j++) {
-	    if (subinfoset->GetLabel() == player->GetInfoset(j)->GetLabel()) {
-	      int id = atoi(subinfoset->GetLabel().c_str());
-	      for (int act = 1; act <= subsupport.NumActions(pl, iset); act++) {
-		int actno = subsupport.GetAction(pl, iset, act)->GetNumber();
-		solns[solns.Length()](pl, id, actno) = sol[solno](pl, iset, act);	  
-	      }
-	      break;
-	    }
+
+    Array<std::map<int, int> > numbers(stage->NumPlayers());
+    NumberInfosets(stage->GetRoot(), numbers);
+
+    for (int solno = 1; solno <= sol.Length(); solno++) {
+      shared_ptr<SubgameSolution> soln(new SubgameSolution(subroots.Length(),
+							   stage->NumPlayers()));
+      for (int i = 1; i <= subroots.Length(); i++) {
+	soln->children[i] = subsolns[i][choice[i]];
+      }
+
+      for (int pl = 1; pl <= stage->NumPlayers(); pl++) {
+	GamePlayer player = stage->GetPlayer(pl);
+	for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+	  typename SubgameSolution::Entry entry;
+	  entry.player = pl;
+	  entry.infoset = numbers[pl][atoi(player->GetInfoset(iset)->GetLabel().c_str())];
+	  for (int act = 1; act <= subsupport.NumActions(pl, iset); act++) {
+	    entry.action = subsupport.GetAction(pl, iset, act)->GetNumber();
+	    entry.prob = sol[solno](pl, iset, act);
+	    soln->entries.Append(entry);
 	  }
 	}
-      }
-      
-      Vector<T> subval(subgame->NumPlayers());
-      GameOutcome outcome = n->GetOutcome();
-      for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-	subval[pl] = sol[solno].GetPayoff(pl);
+
+	soln->value[pl] = sol[solno].GetPayoff(pl);
 	if (outcome) {
-	  subval[pl] += outcome->GetPayoff<T>(pl);
-        }
+	  soln->value[pl] += outcome->GetPayoff<T>(pl);
+	}
       }
 
-      GameOutcome ov = efg->NewOutcome();
-      for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
-	ov->SetPayoff(pl, lexical_cast<std::string>(subval[pl]));
-      }
- 
-      values.Append(ov);
+      solns.Append(soln);
+    }
+
+    // Advance to the next combination, with the last subgame varying fastest
+    int i = subroots.Length();
+    while (i >= 1 && choice[i] == subsolns[i].Length()) {
+      choice[i--] = 1;
+    }
+    if (i == 0) {
+      break;
     }
-    //printf("Finished with scenario %d of %d; total solutions so far = %d\n",
-    //soln, thissolns.Length(), solns.Length());
+    choice[i]++;
   }
 
-  n->DeleteTree();
+  p_solutions = solns;
 }
 
 template <class T>
@@ -423,30 +722,21 @@ SubgameNashBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
     }
   }
 
-  BehaviorSupportProfile support(efg);
-
-  for (int pl = 1; pl <= efg->NumPlayers(); pl++)  {
-    GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-    for (int iset = 1; iset <= player->NumInfosets(); iset++)  {
-      GameInfoset infoset = player->GetInfoset(iset);
-      for (int act = 1; act <= infoset->NumActions(); act++) {
-	if (!p_support.Contains(infoset->GetAction(act))) {
-	  support.RemoveAction(efg->GetPlayer(pl)->GetInfoset(iset)->GetAction(act));
-	}
-      }
-    }
-  }
+  SubgameClassifier classifier;
+  shared_ptr<SubgameLayout> layout = classifier.Classify(efg->GetRoot());
 
-  List<DVector<T> > vectors;
-  List<GameOutcome> values;
-  SolveSubgames(support, DVector<T>(support.NumActions()),
-		efg->GetRoot(), vectors, values);
+  SubgameMemo memo;
+  List<shared_ptr<SubgameSolution> > fragments;
+  SolveSubgame(efg, std::max(m_numThreads, 1), memo, fragments);
 
   List<MixedBehaviorProfile<T> > solutions;
-  for (int i = 1; i <= vectors.Length(); i++) {
+  DVector<T> profile(p_support.NumActions());
+  for (int i = 1; i <= fragments.Length(); i++) {
+    profile = T(0);
+    fragments[i]->Flatten(*layout, profile);
     solutions.Append(MixedBehaviorProfile<T>(p_support));
-    for (int j = 1; j <= vectors[i].Length(); j++) {
-      solutions[i][j] = vectors[i][j];
+    for (int j = 1; j <= profile.Length(); j++) {
+      solutions[i][j] = profile[j];
     }
   }
   for (int i = 1; i <= solutions.Length(); i++) {
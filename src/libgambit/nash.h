@@ -23,6 +23,7 @@
 #ifndef LIBGAMBIT_NASH_H
 #define LIBGAMBIT_NASH_H
 
+#include <map>
 #include "libgambit.h"
 
 namespace Gambit {
@@ -184,23 +185,39 @@ protected:
   shared_ptr<NashStrategySolver<T> > m_solver;
 };
 
+//
+// Solves a game by backward induction on its subgames, using p_solver
+// to solve each subgame once its proper subgames have been replaced by
+// their values.  Sibling subgames are independent, and are solved
+// concurrently by up to p_numThreads threads.  Subgames which are
+// identical apart from labels are solved only once.  Each equilibrium
+// of a subgame is combined with each combination of equilibria of its
+// proper subgames; if p_maxCombinations is positive, at most that many
+// combinations are examined in each subgame.
+//
 template <class T> class SubgameNashBehavSolver : public NashBehavSolver<T> {
 public:
   SubgameNashBehavSolver(shared_ptr<NashBehavSolver<T> > p_solver,
-			 shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0);
+			 shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			 int p_numThreads = 1, int p_maxCombinations = 0);
   virtual ~SubgameNashBehavSolver()  { }
 
   virtual List<MixedBehaviorProfile<T> > Solve(const BehaviorSupportProfile &) const;
 
 protected:
   shared_ptr<NashBehavSolver<T> > m_solver;
+  int m_numThreads, m_maxCombinations;
 
 private:
-  void SolveSubgames(const BehaviorSupportProfile &p_support,
-		     const DVector<T> &p_templateSolution,
-		     GameNode n,
-		     List<DVector<T> > &solns,
-		     List<GameOutcome> &values) const;
+  class SubgameSolution;
+  class SubgameTask;
+  class SubgamePool;
+  typedef std::map<int, List<shared_ptr<SubgameSolution> > > SubgameMemo;
+
+  void SolveSubgame(const Game &p_subgame, int p_numThreads,
+		    SubgameMemo &p_memo,
+		    List<shared_ptr<SubgameSolution> > &p_solutions) const;
+  static void *RunTasks(void *p_pool);
 };
 
 //
@@ -31,7 +31,15 @@ namespace Gambit {
 template <class T> class RectArray {
 protected:
   int minrow, maxrow, mincol, maxcol;
+  /// Row pointers, offset so that data[i][j] addresses entry (i,j)
   T **data;
+  /// The entries, allocated as a single contiguous row-major block.
+  /// Row operations permute the pointers in data, so rows are always
+  /// contiguous, but not necessarily stored in order.
+  T *storage;
+
+  void Allocate(void);
+  void Deallocate(void);
 
 public:
   /// @name Lifecycle
@@ -142,34 +150,45 @@ bool RectArray<T>::CheckBounds(const RectArray<T> &m) const
 //     RectArray<T>: Constructors, destructor, constructive operators
 //------------------------------------------------------------------------
 
+template <class T> void RectArray<T>::Allocate(void)
+{
+  int nrows = maxrow - minrow + 1, ncols = maxcol - mincol + 1;
+  storage = (nrows > 0 && ncols > 0) ? new T[nrows * ncols] : 0;
+  data = (nrows > 0) ? new T *[nrows] - minrow : 0;
+  for (int i = minrow; i <= maxrow; i++) {
+    data[i] = (storage) ? storage + (i - minrow) * ncols - mincol : 0;
+  }
+}
+
+template <class T> void RectArray<T>::Deallocate(void)
+{
+  if (storage)  delete [] storage;
+  if (data)  delete [] (data + minrow);
+}
+
 template <class T> RectArray<T>::RectArray(void)
-  : minrow(1), maxrow(0), mincol(1), maxcol(0), data(0)
+  : minrow(1), maxrow(0), mincol(1), maxcol(0), data(0), storage(0)
 { }
 
 template <class T> RectArray<T>::RectArray(unsigned int rows,
 						 unsigned int cols)
   : minrow(1), maxrow(rows), mincol(1), maxcol(cols)
 {
-  data = (rows > 0) ? new T *[maxrow] - 1 : 0;
-  for (int i = 1; i <= maxrow;
-       data[i++] = (cols > 0) ? new T[maxcol] - 1 : 0);
+  Allocate();
 }
 
 template <class T>
 RectArray<T>::RectArray(int minr, int maxr, int minc, int maxc)
   : minrow(minr), maxrow(maxr), mincol(minc), maxcol(maxc)
 {
-  data = (maxrow >= minrow) ? new T *[maxrow - minrow + 1] - minrow : 0;
-  for (int i = minrow; i <= maxrow;
-       data[i++] = (maxcol - mincol + 1) ? new T[maxcol - mincol + 1] - mincol : 0);
+  Allocate();
 }
 
 template <class T> RectArray<T>::RectArray(const RectArray<T> &a)
   : minrow(a.minrow), maxrow(a.maxrow), mincol(a.mincol), maxcol(a.maxcol)
 {
-  data = (maxrow >= minrow) ? new T *[maxrow - minrow + 1] - minrow : 0;
+  Allocate();
   for (int i = minrow; i <= maxrow; i++)  {
-    data[i] = (maxcol >= mincol) ? new T[maxcol - mincol + 1] - mincol : 0;
     for (int j = mincol; j <= maxcol; j++)
       data[i][j] = a.data[i][j];
   }
@@ -177,29 +196,23 @@ template <class T> RectArray<T>::RectArray(const RectArray<T> &a)
 
 template <class T> RectArray<T>::~RectArray()
 {
-  for (int i = minrow; i <= maxrow; i++)
-    if (data[i])  delete [] (data[i] + mincol);
-  if (data)  delete [] (data + minrow);
+  Deallocate();
 }
 
 template <class T>
 RectArray<T> &RectArray<T>::operator=(const RectArray<T> &a)
 {
   if (this != &a)   {
-    int i;
-    for (i = minrow; i <= maxrow; i++)
-      if (data[i])  delete [] (data[i] + mincol);
-    if (data)  delete [] (data + minrow);
-
-    minrow = a.minrow;
-    maxrow = a.maxrow;
-    mincol = a.mincol;
-    maxcol = a.maxcol;
-    
-    data = (maxrow >= minrow) ? new T *[maxrow - minrow + 1] - minrow : 0;
+    if (!CheckBounds(a)) {
+      Deallocate();
+      minrow = a.minrow;
+      maxrow = a.maxrow;
+      mincol = a.mincol;
+      maxcol = a.maxcol;
+      Allocate();
+    }
   
-    for (i = minrow; i <= maxrow; i++)  {
-      data[i] = (maxcol >= mincol) ? new T[maxcol - mincol + 1] - mincol : 0;
+    for (int i = minrow; i <= maxrow; i++)  {
       for (int j = mincol; j <= maxcol; j++)
 	data[i][j] = a.data[i][j];
     }
@@ -0,0 +1,136 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/stats.cc
+// Counters and phase timings for profiling computations
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <string>
+#include <vector>
+#include <ctime>
+#include <iomanip>
+#include <config.h>
+#if defined(HAVE_SYS_TIME_H)
+#include <sys/time.h>
+#endif  // HAVE_SYS_TIME_H
+#include "stats.h"
+
+namespace Gambit {
+
+unsigned long Statistics::s_counters[Statistics::NumCounters];
+
+namespace {
+
+struct Phase {
+  std::string name;
+  double seconds;
+};
+
+// The phases seen so far, in order of first appearance
+std::vector<Phase> phases;
+// Index of the current phase in phases, or -1 if none
+int currentPhase = -1;
+double phaseStart = 0.0;
+
+double Now(void)
+{
+#if defined(HAVE_SYS_TIME_H)
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + 1.0e-6 * tv.tv_usec;
+#else
+  return (double) std::clock() / (double) CLOCKS_PER_SEC;
+#endif  // HAVE_SYS_TIME_H
+}
+
+}  // end anonymous namespace
+
+const char *Statistics::GetName(Counter p_counter)
+{
+  switch (p_counter) {
+  case Pivots:              return "pivots";
+  case PayoffSweeps:        return "payoff_sweeps";
+  case SolutionRebuilds:    return "solution_rebuilds";
+  case PathSteps:           return "path_steps";
+  case PathRejections:      return "path_rejections";
+  case IntegerAllocations:  return "integer_allocations";
+  case BignumPromotions:    return "bignum_promotions";
+  default:                  return "unknown";
+  }
+}
+
+void Statistics::BeginPhase(const char *p_name)
+{
+  EndPhase();
+  for (size_t i = 0; i < phases.size(); i++) {
+    if (phases[i].name == p_name) {
+      currentPhase = i;
+      break;
+    }
+  }
+  if (currentPhase < 0) {
+    Phase phase;
+    phase.name = p_name;
+    phase.seconds = 0.0;
+    phases.push_back(phase);
+    currentPhase = phases.size() - 1;
+  }
+  phaseStart = Now();
+}
+
+void Statistics::EndPhase(void)
+{
+  if (currentPhase >= 0) {
+    phases[currentPhase].seconds += Now() - phaseStart;
+    currentPhase = -1;
+  }
+}
+
+void Statistics::Reset(void)
+{
+  for (int i = 0; i < NumCounters; i++) {
+    s_counters[i] = 0;
+  }
+  phases.clear();
+  currentPhase = -1;
+}
+
+void Statistics::WriteJSON(std::ostream &p_stream)
+{
+  EndPhase();
+  p_stream << "{\n  \"counters\": {";
+  for (int i = 0; i < NumCounters; i++) {
+    p_stream << ((i > 0) ? ",\n" : "\n");
+    p_stream << "    \"" << GetName((Counter) i) << "\": " << s_counters[i];
+  }
+  p_stream << "\n  },\n  \"phases\": {";
+  std::ios::fmtflags flags = p_stream.flags();
+  std::streamsize precision = p_stream.precision();
+  p_stream.setf(std::ios::fixed, std::ios::floatfield);
+  p_stream.precision(6);
+  for (size_t i = 0; i < phases.size(); i++) {
+    p_stream << ((i > 0) ? ",\n" : "\n");
+    // Phase names are identifiers chosen by the tools, so need no escaping
+    p_stream << "    \"" << phases[i].name << "\": " << phases[i].seconds;
+  }
+  p_stream.flags(flags);
+  p_stream.precision(precision);
+  p_stream << "\n  }\n}" << std::endl;
+}
+
+}  // end namespace Gambit
@@ -0,0 +1,85 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/stats.h
+// Counters and phase timings for profiling computations
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_STATS_H
+#define LIBGAMBIT_STATS_H
+
+#include <iostream>
+
+namespace Gambit {
+
+///
+/// Process-wide statistics on the work done by a computation.
+///
+/// Counters are incremented unconditionally at the points where the
+/// corresponding work is done; an increment is a single memory update,
+/// so the counting is cheap enough to leave enabled.  Counters are not
+/// synchronized, and so are approximate when a solver runs several
+/// threads.
+///
+/// A computation is also divided into consecutive named phases by
+/// calls to BeginPhase(); the elapsed time of each phase is recorded.
+///
+class Statistics {
+public:
+  enum Counter {
+    Pivots = 0,          ///< pivots on a linear tableau
+    PayoffSweeps,        ///< passes over a strategic game's payoff table
+    SolutionRebuilds,    ///< recomputations of a behavior profile's values
+    PathSteps,           ///< accepted steps of a path-following method
+    PathRejections,      ///< rejected steps of a path-following method
+    IntegerAllocations,  ///< allocations of arbitrary-precision integers
+    BignumPromotions,    ///< integers allocated wider than a long
+    NumCounters
+  };
+
+  /// Records one occurrence of the event p_counter
+  static void Count(Counter p_counter) { s_counters[p_counter]++; }
+  /// Records p_number occurrences of the event p_counter
+  static void Count(Counter p_counter, unsigned long p_number)
+    { s_counters[p_counter] += p_number; }
+  /// Returns the number of occurrences of the event p_counter so far
+  static unsigned long GetCount(Counter p_counter)
+    { return s_counters[p_counter]; }
+  /// Returns the name under which p_counter is reported
+  static const char *GetName(Counter p_counter);
+
+  /// Ends the current phase, if any, and starts the phase p_name.
+  /// Time spent in phases of the same name is accumulated.
+  static void BeginPhase(const char *p_name);
+  /// Ends the current phase, if any
+  static void EndPhase(void);
+
+  /// Resets all counters and phase timings
+  static void Reset(void);
+
+  /// Ends the current phase, and writes the counters and phase timings
+  /// (in seconds) as a JSON object
+  static void WriteJSON(std::ostream &p_stream);
+
+private:
+  static unsigned long s_counters[NumCounters];
+};
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_STATS_H
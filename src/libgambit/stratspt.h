@@ -43,6 +43,7 @@ class StrategySupportProfile;
 class StrategySupportProfile {
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class MixedStrategyProfileRep;
+  template <class T> friend class TableMixedStrategyProfileRep;
   template <class T> friend class AggMixedStrategyProfileRep;
   template <class T> friend class BagentMixedStrategyProfileRep;
 protected:
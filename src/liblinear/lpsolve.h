@@ -38,21 +38,33 @@
 // solution.  The components are indexed by the columns of A, with the 
 // excess columns representing the artificial and slack variables.   
 //
+// The right-hand side or the objective can then be changed with
+// SetConst() or SetCost(), which re-solve starting from the previous
+// optimal basis rather than from scratch.  This is usually much faster
+// when the changes are small.
+//
 
 template <class T> class LPSolve {
 private:
   int  well_formed, feasible, bounded, aborted, flag, nvars, neqns,nequals;
   T total_cost,eps1,eps2,eps3,tmin;
   BFS<T> opt_bfs,dual_bfs;
+  Gambit::Matrix<T> matrix;       // the problem, which the tableau refers to
+  Gambit::Vector<T> rhs, objective;
   LPTableau<T> tab;
   Gambit::Array<bool> *UB, *LB;
   Gambit::Array<T> *ub, *lb;
   Gambit::Vector<T> *xx, *cost; 
   Gambit::Vector<T> y, x, d;
+  Gambit::Array<double> weight;   // devex reference weights
 
+  void Start(void);
   void Solve(int phase = 0);
+  void DualSolve(void);
   int Enter(void);
   int Exit(int);
+  void UpdateWeights(int in, int out);
+  void StoreOptimum(void);
 public:
   LPSolve(const Gambit::Matrix<T> &A, const Gambit::Vector<T> &B, const Gambit::Vector<T> &C,
 	  int nequals);   // nequals = number of equalities (last nequals rows)
@@ -61,6 +73,10 @@ public:
 //	  const Gambit::Vector<int> &LB,  const Gambit::Vector<T> &lb, 
 //	  const Gambit::Vector<int> &UB, const Gambit::Vector<T> &ub);
   ~LPSolve();
+
+  // Replace the right-hand side or the objective, and re-solve
+  void SetConst(const Gambit::Vector<T> &B);
+  void SetCost(const Gambit::Vector<T> &C);
   
   T OptimumCost(void) const;
   const Gambit::Vector<T> &OptimumVector(void) const;
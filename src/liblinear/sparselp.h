@@ -0,0 +1,105 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/liblinear/sparselp.h
+// Interface to sparse LP solver
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef SPARSELP_H
+#define SPARSELP_H
+
+#include "libgambit/libgambit.h"
+#include "liblinear/sparsemat.h"
+#include "liblinear/sparselu.h"
+#include "liblinear/bfs.h"
+
+//
+// This class implements a LP solver for large, sparse problems.  As with
+// LPSolve, its constructor takes as input a LP problem of the form
+// maximize c x subject to A x <= b, x >= 0, where the last 'nequals'
+// rows of A are equalities, and all computation is done in the
+// constructor.  A is held as a SparseMatrix, and the storage and the
+// work for each pivot are proportional to its nonzeros rather than to
+// its size.
+//
+// The problem is solved by the revised simplex method in floating point,
+// whatever the type T, with a sparse LU factorization of the basis.  The
+// optimal basis is then factored again in T, and its primal and dual
+// solutions computed and checked.  For T = Rational this check is exact,
+// so the solution reported is exactly optimal; if the check fails, or
+// the problem is found infeasible or unbounded (which is not certified),
+// IsAborted() is true, and the caller should fall back to LPSolve.
+//
+
+template <class T> class SparseLPSolve {
+private:
+  int m_numRows, m_numColumns, m_nequals;
+  bool m_feasible, m_bounded, m_aborted;
+  long m_pivots;
+  T m_optimum;
+  Gambit::Vector<T> m_primal, m_dual;
+  Gambit::Array<bool> m_basic;
+
+  // The problem in floating point.  The variables are the columns of A,
+  // then a logical (slack) variable for each row, then an artificial
+  // variable for each row, used to find a first feasible basis.  The
+  // columns of A are also held by rows, to compute rows of B^{-1} A.
+  CompressedColumns<double> m_matrix, m_byRows;
+  std::vector<double> m_rhs, m_objective, m_cost;
+  std::vector<bool> m_fixed;        // variables which must be zero
+  int m_phase;
+
+  // The basis: the basic variable pivoted on each row, and its value
+  std::vector<int> m_head, m_position;
+  std::vector<double> m_x, m_d, m_weight;
+  SparseLUFactor<double> m_factor;
+
+  std::vector<double> m_alphaRow;
+  std::vector<bool> m_touched;
+
+  void SetPhase(int p_phase);
+  bool Refactor(void);
+  void ComputeReducedCosts(void);
+  int Price(void) const;
+  int RatioTest(const std::vector<double> &p_alpha, double &p_theta) const;
+  void Pivot(int p_in, int p_out, const std::vector<double> &p_alpha,
+	     double p_theta);
+  void Solve(void);
+  void Verify(const SparseMatrix<T> &A, const Gambit::Vector<T> &b,
+	      const Gambit::Vector<T> &c);
+
+public:
+  SparseLPSolve(const SparseMatrix<T> &A, const Gambit::Vector<T> &b,
+		const Gambit::Vector<T> &c, int nequals);
+  ~SparseLPSolve() { }
+
+  bool IsAborted(void) const { return m_aborted; }
+  bool IsFeasible(void) const { return m_feasible; }
+  bool IsBounded(void) const { return m_bounded; }
+  long NumPivots(void) const { return m_pivots; }
+
+  T OptimumCost(void) const { return m_optimum; }
+  // The values of the columns of A, and the dual values of its rows
+  const Gambit::Vector<T> &OptimumVector(void) const { return m_primal; }
+  const Gambit::Vector<T> &DualVector(void) const { return m_dual; }
+  // The basic columns i of A with their values, and the dual values
+  // of the rows i under the keys -i, as for LPSolve::OptBFS()
+  void OptBFS(BFS<T> &p_bfs) const;
+};
+
+#endif   // SPARSELP_H
@@ -0,0 +1,137 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/liblinear/sparselu.h
+// Sparse LU factorization of simplex bases
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef SPARSELU_H
+#define SPARSELU_H
+
+#include <cmath>
+#include <vector>
+#include "libgambit/libgambit.h"
+
+// Magnitudes are compared in floating point, also for exact types
+inline double Magnitude(double x) { return fabs(x); }
+inline double Magnitude(const Gambit::Rational &x) { return fabs((double) x); }
+
+// ---------------------------------------------------------------------------
+// Class CompressedColumns
+// ---------------------------------------------------------------------------
+
+//
+// A matrix in compressed column form.  The entries of column j are
+// index[start[j]], ..., index[start[j+1]-1] (the rows) and the
+// corresponding elements of value.  Rows and columns are numbered from 0.
+//
+template <class T> class CompressedColumns {
+public:
+  int rows;
+  std::vector<int> start, index;
+  std::vector<T> value;
+
+  CompressedColumns(int p_rows = 0) : rows(p_rows), start(1, 0) { }
+
+  int NumColumns(void) const { return start.size() - 1; }
+  void AddEntry(int i, const T &v) { index.push_back(i); value.push_back(v); }
+  void EndColumn(void) { start.push_back(index.size()); }
+};
+
+// ---------------------------------------------------------------------------
+// Class EtaFile
+// ---------------------------------------------------------------------------
+
+//
+// A sequence of elementary matrices, each differing from the identity
+// in one column (or, transposed, one row).  Eta k has pivot row pivot[k],
+// pivot element pivotValue[k], and off-pivot elements given by index and
+// value from start[k] to start[k+1]-1.
+//
+template <class T> class EtaFile {
+public:
+  std::vector<int> start, pivot, index;
+  std::vector<T> pivotValue, value;
+  T zero;
+
+  EtaFile(void) : start(1, 0), zero(0) { }
+
+  void Clear(void);
+  int NumEtas(void) const { return pivot.size(); }
+  int NumEntries(void) const { return index.size(); }
+
+  // An eta is entered by its pivot, then its off-pivot elements
+  void Begin(int p_pivot, const T &p_value)
+    { pivot.push_back(p_pivot); pivotValue.push_back(p_value); }
+  void AddEntry(int i, const T &v) { index.push_back(i); value.push_back(v); }
+  void End(void) { start.push_back(index.size()); }
+
+  // x_p = x_p / d, then x_i -= v_i x_p for the off-pivot elements
+  void Apply(int k, std::vector<T> &x) const;
+  // x_p = (x_p - sum v_i x_i) / d
+  void ApplyTranspose(int k, std::vector<T> &x) const;
+};
+
+// ---------------------------------------------------------------------------
+// Class SparseLUFactor
+// ---------------------------------------------------------------------------
+
+//
+// Factors a square basis taken from the columns of a sparse matrix as
+// B = L U, choosing pivots by the Markowitz criterion with threshold
+// partial pivoting, so that the factors stay sparse.  Later changes of
+// a single column of the basis are held in product form.
+//
+// The basis column in position k is pivoted on row PivotRow(k); the
+// solutions of B x = b computed by Solve() hold the value of the variable
+// for that column in x[PivotRow(k)].  A simplex code therefore keeps the
+// basic variables indexed by their pivot rows.
+//
+template <class T> class SparseLUFactor {
+private:
+  int m_size;
+  EtaFile<T> m_L, m_U, m_R;
+
+public:
+  SparseLUFactor(void) : m_size(0) { }
+
+  // Factors the basis whose columns are p_matrix's columns p_basis.
+  // Elements no larger than p_zeroTol in magnitude are not accepted as
+  // pivots; with p_zeroTol zero, for exact arithmetic, any nonzero
+  // element is.  On return p_pivotRow[k] is the row on which column
+  // p_basis[k] is pivoted; returns false if the basis is singular.
+  bool Factor(const CompressedColumns<T> &p_matrix,
+	      const std::vector<int> &p_basis,
+	      std::vector<int> &p_pivotRow, double p_zeroTol);
+
+  // Replaces the basis column pivoted on row p_row by the column a,
+  // given p_alpha = B^{-1} a, as computed by Solve()
+  void Update(int p_row, const std::vector<T> &p_alpha);
+
+  // Overwrites x with the solution of B y = x
+  void Solve(std::vector<T> &x) const;
+  // Overwrites x with the solution of y B = x
+  void SolveTranspose(std::vector<T> &x) const;
+
+  int NumUpdates(void) const { return m_R.NumEtas(); }
+  int NumFactorEntries(void) const
+    { return m_L.NumEntries() + m_U.NumEntries(); }
+  int NumUpdateEntries(void) const { return m_R.NumEntries(); }
+};
+
+#endif  // SPARSELU_H
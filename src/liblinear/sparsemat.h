@@ -0,0 +1,91 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/liblinear/sparsemat.h
+// Sparse matrix, stored by columns
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef SPARSEMAT_H
+#define SPARSEMAT_H
+
+#include <map>
+#include <vector>
+#include "libgambit/libgambit.h"
+
+//
+// A matrix in which only the entries that have been assigned are stored;
+// all others are zero.  Rows and columns are numbered from 1, as for
+// Gambit::Matrix.  The storage is proportional to the number of entries
+// assigned, so this is suitable for assembling large problems with few
+// nonzeros in each column, such as the sequence form of an extensive game.
+//
+template <class T> class SparseMatrix {
+public:
+  typedef std::map<int, T> Column;
+
+private:
+  int m_numRows;
+  std::vector<Column> m_columns;
+
+public:
+  SparseMatrix(int p_numRows, int p_numColumns)
+    : m_numRows(p_numRows), m_columns(p_numColumns) { }
+
+  int NumRows(void) const { return m_numRows; }
+  int NumColumns(void) const { return m_columns.size(); }
+
+  /// Returns the entry in row i, column j, which is stored if it was not
+  T &operator()(int i, int j)
+  {
+    if (i < 1 || i > m_numRows || j < 1 || j > NumColumns()) {
+      throw Gambit::IndexException();
+    }
+    return m_columns[j - 1][i];
+  }
+  T operator()(int i, int j) const
+  {
+    if (i < 1 || i > m_numRows || j < 1 || j > NumColumns()) {
+      throw Gambit::IndexException();
+    }
+    typename Column::const_iterator entry = m_columns[j - 1].find(i);
+    return (entry != m_columns[j - 1].end()) ? entry->second : T(0);
+  }
+
+  /// The stored entries in column j, keyed by row
+  const Column &GetColumn(int j) const
+  {
+    if (j < 1 || j > NumColumns())  throw Gambit::IndexException();
+    return m_columns[j - 1];
+  }
+
+  /// The matrix with all entries stored
+  Gambit::Matrix<T> GetDense(void) const
+  {
+    Gambit::Matrix<T> dense(1, m_numRows, 1, NumColumns());
+    dense = (T) 0;
+    for (int j = 1; j <= NumColumns(); j++) {
+      for (typename Column::const_iterator entry = m_columns[j - 1].begin();
+	   entry != m_columns[j - 1].end(); ++entry) {
+	dense(entry->first, j) = entry->second;
+      }
+    }
+    return dense;
+  }
+};
+
+#endif   // SPARSEMAT_H
@@ -20,6 +20,7 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include "libgambit/stats.h"
 #include "tableau.h"
 
 // ---------------------------------------------------------------------------
@@ -85,6 +86,7 @@ void Tableau<double>::Pivot(int outrow,int col)
   B.update(outrow, col);
   Solve(*b, solution);
   npivots++;
+  Gambit::Statistics::Count(Gambit::Statistics::Pivots);
   // BigDump(gout);
 }
 
@@ -373,6 +375,7 @@ void Tableau<Gambit::Rational>::Pivot(int outrow,int in_col)
   Tabdat(row,col)=old_denom;
   // BigDump(gout);
   npivots++;
+  Gambit::Statistics::Count(Gambit::Statistics::Pivots);
 
   basis.Pivot(outrow,in_col);
   nonbasic[col] = outlabel;
@@ -477,8 +480,12 @@ void Tableau<Gambit::Rational>::SetRefactor(int)
 
 void Tableau<Gambit::Rational>::SetConst(const Gambit::Vector<Gambit::Rational> &bnew)
 {
+  if(bnew.First()!=b->First() || bnew.Last()!=b->Last())
+    throw Gambit::DimensionException();
   b=&bnew;
   Refactor();
+  for (int i = solution.First();i<=solution.Last();i++) 
+    solution[i] = Gambit::Rational(Coeff[i]*sign(denom*totdenom));
 }
 
 
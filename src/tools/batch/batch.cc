@@ -0,0 +1,597 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/batch/batch.cc
+// Compute Nash equilibria of a collection of games using a pool of workers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#include <getopt.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "libgambit/libgambit.h"
+#if defined(HAVE_WORKING_FORK)
+#include <poll.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#endif  // HAVE_WORKING_FORK
+#include "tools/enumpure/enumpure.h"
+#include "tools/lcp/efglcp.h"
+#include "tools/lcp/nfglcp.h"
+#include "tools/lp/efglp.h"
+#include "tools/lp/nfglp.h"
+
+using namespace Gambit;
+
+void PrintBanner(std::ostream &p_stream)
+{
+  p_stream << "Compute Nash equilibria of a collection of games\n";
+  p_stream << "Gambit version " VERSION ", Copyright (C) 1994-2014, The Gambit Project\n";
+  p_stream << "This is free software, distributed under the GNU GPL\n\n";
+}
+
+void PrintHelp(char *progname)
+{
+  PrintBanner(std::cerr);
+  std::cerr << "Usage: " << progname << " [OPTIONS] [file|directory ...]\n";
+  std::cerr << "Solves each game file given, and each game file in each directory given.\n";
+  std::cerr << "If no files are specified, reads file names from standard input,\n";
+  std::cerr << "one per line.  Each line of output is prefixed by the game's file name.\n\n";
+
+  std::cerr << "Options:\n";
+  std::cerr << "  -a ALGORITHM     method to use: enumpure, lcp (default), or lp\n";
+  std::cerr << "  -d DECIMALS      compute using floating-point arithmetic;\n";
+  std::cerr << "                   display results with DECIMALS digits\n";
+  std::cerr << "  -S               use strategic game\n";
+  std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -e EQA           terminate after finding EQA equilibria (lcp only)\n";
+  std::cerr << "  -j JOBS          solve up to JOBS games at once\n";
+  std::cerr << "                   (default is the number of processors)\n";
+  std::cerr << "  -t SECONDS       abandon a game after SECONDS seconds\n";
+  std::cerr << "                   (default is no limit)\n";
+  std::cerr << "  -D               print detailed information about equilibria\n";
+  std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -q               quiet mode (suppresses banner)\n";
+  std::cerr << "  -v, --version    print version information\n";
+  exit(1);
+}
+
+//=========================================================================
+//                      Solving a single game
+//=========================================================================
+
+struct BatchOptions {
+  std::string algorithm;
+  bool useFloat, useStrategic, bySubgames, printDetail;
+  int numDecimals, stopAfter;
+
+  BatchOptions(void)
+    : algorithm("lcp"), useFloat(false), useStrategic(false),
+      bySubgames(false), printDetail(false), numDecimals(6), stopAfter(0)
+  { }
+};
+
+template <class T> shared_ptr<StrategyProfileRenderer<T> >
+MakeMixedRenderer(std::ostream &p_stream, const BatchOptions &p_options)
+{
+  if (p_options.printDetail) {
+    return new MixedStrategyDetailRenderer<T>(p_stream, p_options.numDecimals);
+  }
+  else {
+    return new MixedStrategyCSVRenderer<T>(p_stream, p_options.numDecimals);
+  }
+}
+
+template <class T> shared_ptr<StrategyProfileRenderer<T> >
+MakeBehavRenderer(std::ostream &p_stream, const BatchOptions &p_options)
+{
+  if (p_options.printDetail) {
+    return new BehavStrategyDetailRenderer<T>(p_stream, p_options.numDecimals);
+  }
+  else {
+    return new BehavStrategyCSVRenderer<T>(p_stream, p_options.numDecimals);
+  }
+}
+
+void SolveEnumPure(const Game &p_game, const BatchOptions &p_options,
+		   std::ostream &p_stream)
+{
+  if (!p_game->IsTree() || p_options.useStrategic) {
+    NashEnumPureStrategySolver
+      algorithm(MakeMixedRenderer<Rational>(p_stream, p_options));
+    algorithm.Solve(p_game);
+  }
+  else if (p_options.bySubgames) {
+    shared_ptr<NashStrategySolver<Rational> > substage =
+      new NashEnumPureStrategySolver();
+    shared_ptr<NashBehavSolver<Rational> > stage =
+      new NashBehavViaStrategySolver<Rational>(substage);
+    SubgameNashBehavSolver<Rational>
+      algorithm(stage, MakeBehavRenderer<Rational>(p_stream, p_options));
+    algorithm.Solve(p_game);
+  }
+  else {
+    // As in gambit-enumpure, equilibria of the reduced strategic game
+    // are reported as behavior profiles
+    NashEnumPureStrategySolver
+      algorithm(MakeBehavRenderer<Rational>(p_stream, p_options));
+    algorithm.Solve(p_game);
+  }
+}
+
+template <class T>
+void SolveLcp(const Game &p_game, const BatchOptions &p_options,
+	      std::ostream &p_stream)
+{
+  if (!p_game->IsTree() || p_options.useStrategic) {
+    NashLcpStrategySolver<T> algorithm(p_options.stopAfter, 0,
+				       MakeMixedRenderer<T>(p_stream, p_options));
+    algorithm.Solve(p_game);
+  }
+  else if (p_options.bySubgames) {
+    shared_ptr<NashBehavSolver<T> > stage =
+      new NashLcpBehaviorSolver<T>(p_options.stopAfter, 0);
+    SubgameNashBehavSolver<T> algorithm(stage,
+					MakeBehavRenderer<T>(p_stream, p_options));
+    algorithm.Solve(p_game);
+  }
+  else {
+    NashLcpBehaviorSolver<T> algorithm(p_options.stopAfter, 0,
+				       MakeBehavRenderer<T>(p_stream, p_options));
+    algorithm.Solve(p_game);
+  }
+}
+
+template <class T>
+void SolveLp(const Game &p_game, const BatchOptions &p_options,
+	     std::ostream &p_stream)
+{
+  if (!p_game->IsTree() || p_options.useStrategic) {
+    NashLpStrategySolver<T> algorithm(MakeMixedRenderer<T>(p_stream, p_options));
+    algorithm.Solve(p_game);
+  }
+  else if (p_options.bySubgames) {
+    shared_ptr<NashBehavSolver<T> > stage = new NashLpBehavSolver<T>();
+    SubgameNashBehavSolver<T> algorithm(stage,
+					MakeBehavRenderer<T>(p_stream, p_options));
+    algorithm.Solve(p_game);
+  }
+  else {
+    NashLpBehavSolver<T> algorithm(MakeBehavRenderer<T>(p_stream, p_options));
+    algorithm.Solve(p_game);
+  }
+}
+
+//
+// Reads the game in p_file and solves it, writing the equilibria found
+// to p_stream.  Returns zero on success; on failure, writes a line
+// starting with "error," and returns nonzero.
+//
+int SolveFile(const std::string &p_file, const BatchOptions &p_options,
+	      std::ostream &p_stream)
+{
+  std::ifstream file_stream(p_file.c_str());
+  if (!file_stream.is_open()) {
+    p_stream << "error," << strerror(errno) << std::endl;
+    return 1;
+  }
+
+  try {
+    Game game = ReadGame(file_stream);
+    if (p_options.algorithm == "enumpure") {
+      SolveEnumPure(game, p_options, p_stream);
+    }
+    else if (p_options.algorithm == "lcp") {
+      if (p_options.useFloat) {
+	SolveLcp<double>(game, p_options, p_stream);
+      }
+      else {
+	SolveLcp<Rational>(game, p_options, p_stream);
+      }
+    }
+    else {
+      if (p_options.useFloat) {
+	SolveLp<double>(game, p_options, p_stream);
+      }
+      else {
+	SolveLp<Rational>(game, p_options, p_stream);
+      }
+    }
+    p_stream.flush();
+    return 0;
+  }
+  catch (std::exception &e) {
+    p_stream << "error," << e.what() << std::endl;
+    return 1;
+  }
+}
+
+//=========================================================================
+//                     Collecting and reporting output
+//=========================================================================
+
+//
+// Writes p_output to standard output, prefixing each line with the
+// name of the game which produced it.
+//
+void WriteTagged(const std::string &p_file, const std::string &p_output)
+{
+  std::string::size_type start = 0;
+  while (start < p_output.length()) {
+    std::string::size_type end = p_output.find('\n', start);
+    if (end == std::string::npos) {
+      // A partial line from a worker which did not finish
+      end = p_output.length();
+    }
+    std::cout << p_file << ',';
+    std::cout.write(p_output.data() + start, end - start);
+    std::cout << '\n';
+    start = end + 1;
+  }
+}
+
+//
+// Appends to p_files the game files in the directory p_dir, in order
+// of name.  Hidden files and subdirectories are skipped.
+//
+void ListDirectory(const std::string &p_dir, std::vector<std::string> &p_files)
+{
+  DIR *dir = opendir(p_dir.c_str());
+  if (!dir) {
+    std::cerr << "gambit-batch: " << p_dir << ": " << strerror(errno) << std::endl;
+    return;
+  }
+  std::vector<std::string> names;
+  for (struct dirent *entry = readdir(dir); entry; entry = readdir(dir)) {
+    if (entry->d_name[0] == '.')  continue;
+    std::string path = p_dir + "/" + entry->d_name;
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+      names.push_back(path);
+    }
+  }
+  closedir(dir);
+  std::sort(names.begin(), names.end());
+  p_files.insert(p_files.end(), names.begin(), names.end());
+}
+
+void AddInput(const std::string &p_path, std::vector<std::string> &p_files)
+{
+  struct stat info;
+  if (stat(p_path.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+    ListDirectory(p_path, p_files);
+  }
+  else {
+    p_files.push_back(p_path);
+  }
+}
+
+//=========================================================================
+//                          The pool of workers
+//=========================================================================
+
+#if defined(HAVE_WORKING_FORK)
+
+//
+// Each game is solved in a child process forked from this one, so the
+// cost of starting a solver is that of a fork, not of loading and
+// initializing a new program.  A worker which runs past the time limit,
+// or which crashes, is killed without affecting the other games.
+//
+class WorkerPool {
+private:
+  struct Worker {
+    int index;         // position of the game in the input
+    pid_t pid;
+    int fd;            // read end of the pipe carrying the worker's output
+    double deadline;   // zero if there is no time limit
+    bool timedOut;
+  };
+
+  const std::vector<std::string> &m_files;
+  const BatchOptions &m_options;
+  int m_numJobs;
+  double m_timeout;
+
+  std::vector<Worker> m_running;
+  // Output of each game, with results reported in input order
+  std::vector<std::string> m_output;
+  std::vector<bool> m_finished;
+  int m_nextStart, m_nextReport;
+
+  static double Now(void);
+  bool Start(int p_index);
+  void Finish(int p_slot);
+  void Report(void);
+
+public:
+  WorkerPool(const std::vector<std::string> &p_files,
+	     const BatchOptions &p_options, int p_numJobs, double p_timeout)
+    : m_files(p_files), m_options(p_options), m_numJobs(p_numJobs),
+      m_timeout(p_timeout), m_output(p_files.size()),
+      m_finished(p_files.size(), false), m_nextStart(0), m_nextReport(0)
+  { }
+
+  void Run(void);
+};
+
+double WorkerPool::Now(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + 1.0e-6 * tv.tv_usec;
+}
+
+bool WorkerPool::Start(int p_index)
+{
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return false;
+  }
+  // Anything still buffered would otherwise be written again by the child
+  std::cout.flush();
+  std::cerr.flush();
+
+  pid_t pid = fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[1]);
+    int status = SolveFile(m_files[p_index], m_options, std::cout);
+    std::cout.flush();
+    _exit(status);
+  }
+
+  close(fds[1]);
+  Worker worker;
+  worker.index = p_index;
+  worker.pid = pid;
+  worker.fd = fds[0];
+  worker.deadline = (m_timeout > 0.0) ? Now() + m_timeout : 0.0;
+  worker.timedOut = false;
+  m_running.push_back(worker);
+  return true;
+}
+
+void WorkerPool::Finish(int p_slot)
+{
+  Worker &worker = m_running[p_slot];
+  close(worker.fd);
+  int status = 0;
+  while (waitpid(worker.pid, &status, 0) < 0 && errno == EINTR);
+
+  std::string &output = m_output[worker.index];
+  if (worker.timedOut) {
+    if (!output.empty() && output[output.length() - 1] != '\n') {
+      output += '\n';
+    }
+    output += "timeout\n";
+  }
+  else if (WIFSIGNALED(status)) {
+    if (!output.empty() && output[output.length() - 1] != '\n') {
+      output += '\n';
+    }
+    output += "error,terminated by signal ";
+    std::ostringstream s;
+    s << WTERMSIG(status);
+    output += s.str() + "\n";
+  }
+  m_finished[worker.index] = true;
+  m_running.erase(m_running.begin() + p_slot);
+}
+
+void WorkerPool::Report(void)
+{
+  while (m_nextReport < (int) m_files.size() && m_finished[m_nextReport]) {
+    WriteTagged(m_files[m_nextReport], m_output[m_nextReport]);
+    std::string().swap(m_output[m_nextReport]);
+    m_nextReport++;
+  }
+  std::cout.flush();
+}
+
+void WorkerPool::Run(void)
+{
+  std::vector<struct pollfd> fds;
+  char buffer[4096];
+
+  while (m_nextReport < (int) m_files.size()) {
+    while ((int) m_running.size() < m_numJobs &&
+	   m_nextStart < (int) m_files.size()) {
+      if (!Start(m_nextStart)) {
+	if (!m_running.empty())  break;
+	// No worker could be started at all; solve the game here instead
+	std::ostringstream s;
+	SolveFile(m_files[m_nextStart], m_options, s);
+	m_output[m_nextStart] = s.str();
+	m_finished[m_nextStart] = true;
+      }
+      m_nextStart++;
+    }
+    if (m_running.empty()) {
+      Report();
+      continue;
+    }
+
+    double now = Now();
+    int wait = -1;
+    fds.resize(m_running.size());
+    for (size_t i = 0; i < m_running.size(); i++) {
+      fds[i].fd = m_running[i].fd;
+      fds[i].events = POLLIN;
+      fds[i].revents = 0;
+      if (m_running[i].deadline > 0.0) {
+	int left = std::max(0, (int) (1000.0 * (m_running[i].deadline - now)) + 1);
+	if (wait < 0 || left < wait)  wait = left;
+      }
+    }
+    if (poll(&fds[0], fds.size(), wait) < 0 && errno != EINTR) {
+      perror("gambit-batch: poll");
+      exit(1);
+    }
+
+    now = Now();
+    for (int i = (int) m_running.size() - 1; i >= 0; i--) {
+      Worker &worker = m_running[i];
+      if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+	ssize_t n = read(worker.fd, buffer, sizeof(buffer));
+	if (n > 0) {
+	  m_output[worker.index].append(buffer, n);
+	}
+	else if (n == 0 || errno != EINTR) {
+	  Finish(i);
+	  continue;
+	}
+      }
+      if (worker.deadline > 0.0 && now >= worker.deadline) {
+	kill(worker.pid, SIGKILL);
+	worker.timedOut = true;
+	Finish(i);
+      }
+    }
+    Report();
+  }
+}
+
+#endif  // HAVE_WORKING_FORK
+
+
+int main(int argc, char *argv[])
+{
+  int c;
+  bool quiet = false;
+  BatchOptions options;
+  int numJobs = 1;
+#if defined(_SC_NPROCESSORS_ONLN)
+  numJobs = std::max(1, (int) sysconf(_SC_NPROCESSORS_ONLN));
+#endif  // _SC_NPROCESSORS_ONLN
+  double timeout = 0.0;
+
+  int long_opt_index = 0;
+  struct option long_options[] = {
+    { "help", 0, NULL, 'h'   },
+    { "version", 0, NULL, 'v'  },
+    { 0,    0,    0,    0   }
+  };
+  while ((c = getopt_long(argc, argv, "a:d:DvhqSPe:j:t:", long_options, &long_opt_index)) != -1) {
+    switch (c) {
+    case 'v':
+      PrintBanner(std::cerr); exit(1);
+    case 'a':
+      options.algorithm = optarg;
+      if (options.algorithm != "enumpure" && options.algorithm != "lcp" &&
+	  options.algorithm != "lp") {
+	std::cerr << argv[0] << ": Unknown algorithm `" << optarg << "'.\n";
+	return 1;
+      }
+      break;
+    case 'd':
+      options.useFloat = true;
+      options.numDecimals = atoi(optarg);
+      break;
+    case 'D':
+      options.printDetail = true;
+      break;
+    case 'e':
+      options.stopAfter = atoi(optarg);
+      break;
+    case 'j':
+      numJobs = std::max(1, atoi(optarg));
+      break;
+    case 't':
+      timeout = atof(optarg);
+      break;
+    case 'h':
+      PrintHelp(argv[0]);
+      break;
+    case 'q':
+      quiet = true;
+      break;
+    case 'S':
+      options.useStrategic = true;
+      break;
+    case 'P':
+      options.bySubgames = true;
+      break;
+    case '?':
+      if (isprint(optopt)) {
+	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
+      }
+      else {
+	std::cerr << argv[0] << ": Unknown option character `\\x" << optopt << "`.\n";
+      }
+      return 1;
+    default:
+      abort();
+    }
+  }
+
+  if (!quiet) {
+    PrintBanner(std::cerr);
+  }
+
+  std::vector<std::string> files;
+  if (optind < argc) {
+    for (int i = optind; i < argc; i++) {
+      AddInput(argv[i], files);
+    }
+  }
+  else {
+    std::string line;
+    while (std::getline(std::cin, line)) {
+      if (!line.empty() && line[line.length() - 1] == '\r') {
+	line.erase(line.length() - 1);
+      }
+      if (!line.empty()) {
+	AddInput(line, files);
+      }
+    }
+  }
+
+#if defined(HAVE_WORKING_FORK)
+  WorkerPool pool(files, options, numJobs, timeout);
+  pool.Run();
+#else
+  if (timeout > 0.0) {
+    std::cerr << argv[0] << ": time limits are not supported on this platform\n";
+  }
+  for (size_t i = 0; i < files.size(); i++) {
+    std::ostringstream s;
+    SolveFile(files[i], options, s);
+    WriteTagged(files[i], s.str());
+  }
+  std::cout.flush();
+#endif  // HAVE_WORKING_FORK
+  return 0;
+}
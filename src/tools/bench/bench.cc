@@ -0,0 +1,576 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/bench/bench.cc
+// Benchmarks of library kernels and of the command-line solvers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "libgambit/libgambit.h"
+#include "libgambit/gamegen.h"
+#include "liblinear/tableau.h"
+#if defined(HAVE_SYS_TIME_H)
+#include <sys/time.h>
+#endif  // HAVE_SYS_TIME_H
+#if defined(HAVE_WORKING_FORK)
+#include <fcntl.h>
+#include <sys/wait.h>
+#endif  // HAVE_WORKING_FORK
+
+using namespace Gambit;
+
+void PrintBanner(std::ostream &p_stream)
+{
+  p_stream << "Benchmark library kernels and command-line solvers\n";
+  p_stream << "Gambit version " VERSION ", Copyright (C) 1994-2014, The Gambit Project\n";
+  p_stream << "This is free software, distributed under the GNU GPL\n\n";
+}
+
+void PrintHelp(char *progname)
+{
+  PrintBanner(std::cerr);
+  std::cerr << "Usage: " << progname << " [OPTIONS]\n";
+  std::cerr << "Times library kernels, and optionally the solvers, on a fixed set\n";
+  std::cerr << "of generated games.  Writes one line per benchmark, giving the\n";
+  std::cerr << "mean and minimum time in seconds of one repetition.\n\n";
+
+  std::cerr << "Options:\n";
+  std::cerr << "  -s DIR           also time the gambit-* programs found in DIR\n";
+  std::cerr << "  -K               do not time the library kernels\n";
+  std::cerr << "  -w DIR           write the generated games to DIR\n";
+  std::cerr << "                   (default is bench-games)\n";
+  std::cerr << "  -t SECONDS       minimum time to spend on each kernel (default 1)\n";
+  std::cerr << "  -r COUNT         number of runs of each solver (default 3)\n";
+  std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -q               quiet mode (suppresses banner)\n";
+  std::cerr << "  -v, --version    print version information\n";
+  exit(1);
+}
+
+//=========================================================================
+//                          Generated games
+//=========================================================================
+
+//
+// A strategic game of the given dimensions, with payoffs drawn uniformly
+// from 0 to 99.  If p_zeroSum is set, the last player's payoff is instead
+// the negative of the sum of the others'.
+//
+Game RandomTable(unsigned long p_seed, const Array<int> &p_dim,
+		 bool p_zeroSum = false)
+{
+  GameRandom random(p_seed);
+  return ((p_zeroSum) ? ZeroSumTableGame(p_dim, random, 99) :
+	  RandomTableGame(p_dim, random, 99));
+}
+
+Game RandomTable(unsigned long p_seed, int p_numPlayers, int p_numStrategies,
+		 bool p_zeroSum = false)
+{
+  Array<int> dim(p_numPlayers);
+  for (int pl = 1; pl <= p_numPlayers; pl++) {
+    dim[pl] = p_numStrategies;
+  }
+  return RandomTable(p_seed, dim, p_zeroSum);
+}
+
+//
+// A two-player tree of the given depth, in which the players alternate
+// and each move has p_numActions actions.  Children of the same node
+// share an information set, so each player observes all moves but the
+// opponent's most recent one; the game has perfect recall.
+//
+Game RandomTree(unsigned long p_seed, int p_depth, int p_numActions,
+		bool p_zeroSum = false)
+{
+  GameRandom random(p_seed);
+  return RandomTreeGame(2, p_depth, p_numActions, false, p_zeroSum,
+			random, 99);
+}
+
+void WriteGame(const Game &p_game, const std::string &p_file)
+{
+  std::ofstream file(p_file.c_str());
+  if (!file.is_open()) {
+    std::cerr << "gambit-bench: " << p_file << ": " << strerror(errno) << std::endl;
+    exit(1);
+  }
+  p_game->Write(file);
+}
+
+//=========================================================================
+//                        Timing and reporting
+//=========================================================================
+
+double Now(void)
+{
+#if defined(HAVE_SYS_TIME_H)
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + 1.0e-6 * tv.tv_usec;
+#else
+  return (double) std::clock() / (double) CLOCKS_PER_SEC;
+#endif  // HAVE_SYS_TIME_H
+}
+
+//
+// Each line of output gives the name of the benchmark, the number of
+// repetitions timed, and the mean and minimum time of a repetition.
+// Names are fixed, so results of different runs can be joined on them.
+//
+void Report(const std::string &p_name, long p_repetitions,
+	    double p_mean, double p_min)
+{
+  std::cout << p_name << ',' << p_repetitions << ',';
+  std::cout << std::scientific << std::setprecision(6);
+  std::cout << p_mean << ',' << p_min << std::endl;
+}
+
+/// One repetition of a kernel benchmark
+class Kernel {
+public:
+  virtual ~Kernel() { }
+  virtual void Run(void) = 0;
+};
+
+//
+// Times the kernel in five batches, after calibrating the size of a
+// batch so that all five take about p_minTime seconds.
+//
+void TimeKernel(const std::string &p_name, Kernel &p_kernel, double p_minTime)
+{
+  const int numBatches = 5;
+  long count = 1;
+  while (true) {
+    double start = Now();
+    for (long i = 0; i < count; i++)  p_kernel.Run();
+    double elapsed = Now() - start;
+    if (elapsed >= p_minTime / numBatches)  break;
+    if (elapsed <= 0.0) {
+      count *= 10;
+    }
+    else {
+      count = std::max(count + 1,
+		       (long) (1.2 * count * (p_minTime / numBatches) / elapsed));
+    }
+  }
+
+  double total = 0.0, best = -1.0;
+  for (int batch = 1; batch <= numBatches; batch++) {
+    double start = Now();
+    for (long i = 0; i < count; i++)  p_kernel.Run();
+    double elapsed = (Now() - start) / count;
+    total += elapsed;
+    if (best < 0.0 || elapsed < best)  best = elapsed;
+  }
+  Report(p_name, numBatches * count, total / numBatches, best);
+}
+
+//=========================================================================
+//                              Kernels
+//=========================================================================
+
+class TablePayoffKernel : public Kernel {
+private:
+  MixedStrategyProfile<double> m_profile;
+
+public:
+  TablePayoffKernel(const Game &p_game) : m_profile(p_game->NewMixedStrategyProfile(0.0)) { }
+  void Run(void)
+  {
+    for (int pl = 1; pl <= m_profile.GetGame()->NumPlayers(); pl++) {
+      m_profile.GetPayoff(pl);
+    }
+  }
+};
+
+class TablePayoffDerivKernel : public Kernel {
+private:
+  MixedStrategyProfile<double> m_profile;
+
+public:
+  TablePayoffDerivKernel(const Game &p_game)
+    : m_profile(p_game->NewMixedStrategyProfile(0.0)) { }
+  void Run(void)
+  {
+    Game game = m_profile.GetGame();
+    for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+      GamePlayer player = game->GetPlayer(pl);
+      for (int st = 1; st <= player->NumStrategies(); st++) {
+	m_profile.GetPayoffDeriv(pl, player->GetStrategy(st));
+      }
+    }
+  }
+};
+
+class SolutionDataKernel : public Kernel {
+private:
+  MixedBehaviorProfile<double> m_profile;
+
+public:
+  SolutionDataKernel(const Game &p_game) : m_profile(p_game) { }
+  void Run(void)
+  {
+    // Writing a probability invalidates the cached values, so the
+    // payoff query recomputes them
+    m_profile[1] = m_profile[1];
+    m_profile.GetPayoff(1);
+  }
+};
+
+class RationalKernel : public Kernel {
+public:
+  void Run(void)
+  {
+    // Partial sums of the harmonic series, whose denominators grow
+    // beyond the range of a machine integer
+    Rational sum(0);
+    for (int i = 1; i <= 60; i++) {
+      sum += Rational(1, i);
+    }
+    Rational product(1);
+    for (int i = 1; i <= 20; i++) {
+      product *= sum / Rational(i + 1, i);
+    }
+  }
+};
+
+class IntegerKernel : public Kernel {
+public:
+  void Run(void)
+  {
+    Integer factorial(1);
+    for (int i = 2; i <= 60; i++) {
+      factorial *= i;
+    }
+    Integer quotient = factorial;
+    for (int i = 2; i <= 30; i++) {
+      quotient /= i;
+    }
+    Integer divisor = gcd(factorial, quotient * 7 + 1);
+  }
+};
+
+//
+// Each repetition pivots the columns of a random square matrix into
+// the basis, one per row, and then pivots the slacks back in.
+//
+template <class T> class TableauKernel : public Kernel {
+private:
+  Matrix<T> m_matrix;
+  Vector<T> m_rhs;
+
+public:
+  TableauKernel(unsigned long p_seed, int p_size)
+    : m_matrix(1, p_size, 1, p_size), m_rhs(1, p_size)
+  {
+    GameRandom random(p_seed);
+    for (int i = 1; i <= p_size; i++) {
+      for (int j = 1; j <= p_size; j++) {
+	m_matrix(i, j) = (T) (1 + random.NextInt(9));
+      }
+      m_rhs[i] = (T) 1;
+    }
+  }
+  void Run(void)
+  {
+    Tableau<T> tableau(m_matrix, m_rhs);
+    for (int j = 1; j <= m_matrix.NumColumns(); j++) {
+      if (tableau.CanPivot(tableau.Label(j), j))  tableau.Pivot(j, j);
+    }
+    for (int j = 1; j <= m_matrix.NumColumns(); j++) {
+      if (tableau.CanPivot(tableau.Label(j), -j))  tableau.Pivot(j, -j);
+    }
+  }
+};
+
+class ReadGameKernel : public Kernel {
+private:
+  std::string m_text;
+
+public:
+  ReadGameKernel(const Game &p_game)
+  {
+    std::ostringstream s;
+    p_game->Write(s);
+    m_text = s.str();
+  }
+  void Run(void)
+  {
+    std::istringstream s(m_text);
+    ReadGame(s);
+  }
+};
+
+void RunKernels(double p_minTime)
+{
+  Game table = RandomTable(1, 3, 12);
+  Game tree = RandomTree(2, 10, 2);
+
+  {
+    TablePayoffKernel kernel(table);
+    TimeKernel("kernel.table_payoff.3x12", kernel, p_minTime);
+  }
+  {
+    TablePayoffDerivKernel kernel(table);
+    TimeKernel("kernel.table_payoff_deriv.3x12", kernel, p_minTime);
+  }
+  {
+    SolutionDataKernel kernel(tree);
+    TimeKernel("kernel.behav_solution_data.tree_d10", kernel, p_minTime);
+  }
+  {
+    RationalKernel kernel;
+    TimeKernel("kernel.rational_arithmetic", kernel, p_minTime);
+  }
+  {
+    IntegerKernel kernel;
+    TimeKernel("kernel.integer_arithmetic", kernel, p_minTime);
+  }
+  {
+    TableauKernel<double> kernel(3, 30);
+    TimeKernel("kernel.tableau_pivot.double_30", kernel, p_minTime);
+  }
+  {
+    TableauKernel<Rational> kernel(3, 12);
+    TimeKernel("kernel.tableau_pivot.rational_12", kernel, p_minTime);
+  }
+  {
+    ReadGameKernel kernel(RandomTable(4, 3, 20));
+    TimeKernel("kernel.read_game.nfg_3x20", kernel, p_minTime);
+  }
+  {
+    ReadGameKernel kernel(RandomTree(5, 10, 2));
+    TimeKernel("kernel.read_game.efg_d10", kernel, p_minTime);
+  }
+}
+
+//=========================================================================
+//                               Solvers
+//=========================================================================
+
+//
+// The games on which the solvers are timed.  They are regenerated on
+// every run from fixed seeds, so they never change.
+//
+void WriteCorpus(const std::string &p_dir)
+{
+  WriteGame(RandomTable(11, 2, 3), p_dir + "/nfg2_3.nfg");
+  WriteGame(RandomTable(12, 2, 8), p_dir + "/nfg2_8.nfg");
+  WriteGame(RandomTable(13, 2, 10, true), p_dir + "/nfg2_10_zerosum.nfg");
+  WriteGame(RandomTable(14, 3, 4), p_dir + "/nfg3_4.nfg");
+  WriteGame(RandomTable(15, 3, 10), p_dir + "/nfg3_10.nfg");
+  WriteGame(RandomTree(16, 6, 2), p_dir + "/efg2_d6.efg");
+  WriteGame(RandomTree(17, 6, 2, true), p_dir + "/efg2_d6_zerosum.efg");
+}
+
+struct SolverRun {
+  const char *name, *program, *options, *game;
+};
+
+const SolverRun solverRuns[] = {
+  { "solver.enummixed.nfg2_8", "gambit-enummixed", "-q", "nfg2_8.nfg" },
+  { "solver.enumpoly.nfg2_3", "gambit-enumpoly", "-q", "nfg2_3.nfg" },
+  { "solver.enumpure.nfg3_10", "gambit-enumpure", "-q", "nfg3_10.nfg" },
+  { "solver.enumpure.efg2_d6", "gambit-enumpure", "-q", "efg2_d6.efg" },
+  { "solver.gnm.nfg3_4", "gambit-gnm", "-q", "nfg3_4.nfg" },
+  { "solver.ipa.nfg3_4", "gambit-ipa", "-q", "nfg3_4.nfg" },
+  { "solver.lcp.nfg2_8", "gambit-lcp", "-q", "nfg2_8.nfg" },
+  { "solver.lcp.nfg2_8.float", "gambit-lcp", "-q -d 10", "nfg2_8.nfg" },
+  { "solver.lcp.efg2_d6.first", "gambit-lcp", "-q -e 1", "efg2_d6.efg" },
+  { "solver.liap.nfg3_4", "gambit-liap", "-q", "nfg3_4.nfg" },
+  { "solver.logit.nfg3_4", "gambit-logit", "-q -e", "nfg3_4.nfg" },
+  { "solver.logit.efg2_d6", "gambit-logit", "-q -e", "efg2_d6.efg" },
+  { "solver.lp.nfg2_10_zerosum", "gambit-lp", "-q", "nfg2_10_zerosum.nfg" },
+  { "solver.lp.efg2_d6_zerosum", "gambit-lp", "-q", "efg2_d6_zerosum.efg" },
+  { "solver.simpdiv.nfg3_4", "gambit-simpdiv", "-q", "nfg3_4.nfg" },
+  { 0, 0, 0, 0 }
+};
+
+//
+// Runs p_program with output discarded.  Returns false if the program
+// could not be run or did not succeed.
+//
+bool RunProgram(const std::string &p_program, const std::string &p_options,
+		const std::string &p_game)
+{
+#if defined(HAVE_WORKING_FORK)
+  std::vector<std::string> args;
+  args.push_back(p_program);
+  std::istringstream options(p_options);
+  std::string option;
+  while (options >> option)  args.push_back(option);
+  args.push_back(p_game);
+
+  pid_t pid = fork();
+  if (pid < 0)  return false;
+  if (pid == 0) {
+    std::vector<char *> argv;
+    for (size_t i = 0; i < args.size(); i++) {
+      argv.push_back(const_cast<char *>(args[i].c_str()));
+    }
+    argv.push_back(0);
+    int null = open("/dev/null", O_WRONLY);
+    if (null >= 0) {
+      dup2(null, STDOUT_FILENO);
+      dup2(null, STDERR_FILENO);
+    }
+    execv(p_program.c_str(), &argv[0]);
+    _exit(127);
+  }
+  int status;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR)  return false;
+  }
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#else
+#if defined(_WIN32)
+  const char *devnull = "NUL";
+#else
+  const char *devnull = "/dev/null";
+#endif  // _WIN32
+  std::string command = "\"" + p_program + "\" " + p_options + " \"" +
+    p_game + "\" > " + devnull + " 2>&1";
+  return system(command.c_str()) == 0;
+#endif  // HAVE_WORKING_FORK
+}
+
+void RunSolvers(const std::string &p_binDir, const std::string &p_gameDir,
+		int p_repetitions)
+{
+  WriteCorpus(p_gameDir);
+  for (int i = 0; solverRuns[i].name; i++) {
+    const SolverRun &run = solverRuns[i];
+    std::string program = p_binDir + "/" + run.program;
+    if (access(program.c_str(), X_OK) != 0) {
+      std::cerr << "gambit-bench: skipping " << run.name << ": "
+		<< program << " not found\n";
+      continue;
+    }
+
+    double total = 0.0, best = -1.0;
+    bool ok = true;
+    for (int rep = 1; ok && rep <= p_repetitions; rep++) {
+      double start = Now();
+      ok = RunProgram(program, run.options, p_gameDir + "/" + run.game);
+      double elapsed = Now() - start;
+      total += elapsed;
+      if (best < 0.0 || elapsed < best)  best = elapsed;
+    }
+    if (!ok) {
+      std::cerr << "gambit-bench: " << run.name << " failed\n";
+      continue;
+    }
+    Report(run.name, p_repetitions, total / p_repetitions, best);
+  }
+}
+
+
+int main(int argc, char *argv[])
+{
+  int c;
+  bool quiet = false, runKernels = true;
+  std::string binDir, gameDir = "bench-games";
+  double minTime = 1.0;
+  int repetitions = 3;
+
+  int long_opt_index = 0;
+  struct option long_options[] = {
+    { "help", 0, NULL, 'h'   },
+    { "version", 0, NULL, 'v'  },
+    { 0,    0,    0,    0   }
+  };
+  while ((c = getopt_long(argc, argv, "s:Kw:t:r:vhq", long_options, &long_opt_index)) != -1) {
+    switch (c) {
+    case 'v':
+      PrintBanner(std::cerr); exit(1);
+    case 's':
+      binDir = optarg;
+      break;
+    case 'K':
+      runKernels = false;
+      break;
+    case 'w':
+      gameDir = optarg;
+      break;
+    case 't':
+      minTime = atof(optarg);
+      break;
+    case 'r':
+      repetitions = std::max(1, atoi(optarg));
+      break;
+    case 'h':
+      PrintHelp(argv[0]);
+      break;
+    case 'q':
+      quiet = true;
+      break;
+    case '?':
+      if (isprint(optopt)) {
+	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
+      }
+      else {
+	std::cerr << argv[0] << ": Unknown option character `\\x" << optopt << "`.\n";
+      }
+      return 1;
+    default:
+      abort();
+    }
+  }
+
+  if (!quiet) {
+    PrintBanner(std::cerr);
+  }
+
+  try {
+    std::cout << "benchmark,repetitions,mean_seconds,min_seconds" << std::endl;
+    if (runKernels) {
+      RunKernels(minTime);
+    }
+    if (binDir != "") {
+      struct stat info;
+      if (stat(gameDir.c_str(), &info) != 0) {
+#if defined(_WIN32)
+	mkdir(gameDir.c_str());
+#else
+	mkdir(gameDir.c_str(), 0777);
+#endif  // _WIN32
+      }
+      RunSolvers(binDir, gameDir, repetitions);
+    }
+    return 0;
+  }
+  catch (std::runtime_error &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
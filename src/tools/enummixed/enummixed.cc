@@ -27,8 +27,12 @@
 #include <fstream>
 #include <cerrno>
 #include <iomanip>
+#include <vector>
+#include <map>
+#include <algorithm>
 
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 #include "clique.h"
 #include "vertenum.imp"
 
@@ -49,6 +53,69 @@ bool EqZero(const Rational &x)
   return (x == Gambit::Rational(0));
 }
 
+//
+// A value is significant if its product with any other significant
+// value is not EqZero().  Two vertices with significant entries in
+// complementary positions therefore cannot form an equilibrium.
+//
+bool IsSignificant(const double &x)
+{
+  double eps = ::pow(10.0, -7.0);
+  return (x > eps || x < -eps);
+}
+
+bool IsSignificant(const Rational &x)
+{
+  return (x != Gambit::Rational(0));
+}
+
+//
+// A set of labels (strategy indices) of a vertex, stored as a bitset
+//
+class LabelSet {
+private:
+  std::vector<unsigned long> m_bits;
+
+  static const int c_wordBits = 8 * sizeof(unsigned long);
+
+public:
+  LabelSet(int p_size) : m_bits(p_size / c_wordBits + 1, 0) { }
+
+  void Insert(int p_label)
+  { m_bits[p_label / c_wordBits] |= 1UL << (p_label % c_wordBits); }
+
+  bool Intersects(const LabelSet &p_set) const
+  {
+    for (size_t i = 0; i < m_bits.size(); i++) {
+      if (m_bits[i] & p_set.m_bits[i])  return true;
+    }
+    return false;
+  }
+
+  bool operator<(const LabelSet &p_set) const
+  { return m_bits < p_set.m_bits; }
+};
+
+//
+// Returns the strategies with significant weight at the vertex, and the
+// constraints with significant slack
+//
+template <class T>
+void GetLabels(BFS<T> p_bfs, int p_numStrats, int p_numConstraints,
+	       LabelSet &p_support, LabelSet &p_slack)
+{
+  for (int k = 1; k <= p_numStrats; k++) {
+    if (p_bfs.count(k) && IsSignificant(p_bfs[k])) {
+      p_support.Insert(k);
+    }
+  }
+  for (int k = 1; k <= p_numConstraints; k++) {
+    if (p_bfs.count(-k) && IsSignificant(p_bfs[-k])) {
+      p_slack.Insert(k);
+    }
+  }
+}
+
 int m_stopAfter = 0;
 
 void PrintProfile(std::ostream &p_stream,
@@ -118,7 +185,7 @@ template <class T> void GetCliques(std::ostream &p_stream,
   }
 }
 
-template <class T> void Solve(const Game &p_game)
+template <class T> void Solve(const Game &p_game, int p_numThreads)
 {
   List<Vector<T> > key1, key2;  
   List<int> node1, node2;   // IDs of each component of the extreme equilibria
@@ -160,8 +227,8 @@ template <class T> void Solve(const Game &p_game)
   b2 = (T) -1;
 
   // enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0
-  VertEnum<T> poly1(A1, b1);
-  VertEnum<T> poly2(A2, b2);
+  VertEnum<T> poly1(A1, b1, p_numThreads);
+  VertEnum<T> poly2(A2, b2, p_numThreads);
 
   const List<BFS<T> > &verts1(poly1.VertexList());
   const List<BFS<T> > &verts2(poly2.VertexList());
@@ -173,13 +240,42 @@ template <class T> void Solve(const Game &p_game)
   for (int i = 1; i <= vert1id.Length(); vert1id[i++] = 0);
   for (int i = 1; i <= vert2id.Length(); vert2id[i++] = 0);
 
-  int i = 0;
+  int n1 = p_game->Players()[1]->Strategies().size();
+  int n2 = p_game->Players()[2]->Strategies().size();
+
+  // Index the vertices of the first polytope by their supports, so
+  // candidate partners of a vertex are found by looking only at the
+  // supports disjoint from its slack constraints
+  typedef std::map<LabelSet, std::vector<int> > SupportMap;
+  SupportMap supports1;
+  std::vector<LabelSet> slacks1(v1 + 1, LabelSet(n1));
+  for (int i1 = 2; i1 <= v1; i1++) {
+    LabelSet support(n2);
+    GetLabels(verts1[i1], n2, n1, support, slacks1[i1]);
+    supports1[support].push_back(i1);
+  }
+
   int id1 = 0, id2 = 0;
 
   for (int i2 = 2; i2 <= v2; i2++) {
     BFS<T> bfs1 = verts2[i2];
-    i++;
-    for (int i1 = 2; i1 <= v1; i1++) {
+    LabelSet support2(n1), slack2(n2);
+    GetLabels(bfs1, n1, n2, support2, slack2);
+
+    std::vector<int> candidates;
+    for (typename SupportMap::const_iterator bucket = supports1.begin();
+	 bucket != supports1.end(); ++bucket) {
+      if (bucket->first.Intersects(slack2))  continue;
+      for (size_t j = 0; j < bucket->second.size(); j++) {
+	if (!support2.Intersects(slacks1[bucket->second[j]])) {
+	  candidates.push_back(bucket->second[j]);
+	}
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (size_t j = 0; j < candidates.size(); j++) {
+      int i1 = candidates[j];
       BFS<T> bfs2 = verts1[i1];
 	
       // check if solution is nash 
@@ -261,7 +357,10 @@ void PrintHelp(char *progname)
   std::cerr << "  -D               don't eliminate dominated strategies first\n";
   std::cerr << "  -L               use lrslib for enumeration (experimental!)\n";
   std::cerr << "  -c               output connectedness information\n";
+  std::cerr << "  -t THREADS       number of threads to use for exact enumeration\n";
+  std::cerr << "                   (default is the number of processors)\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          print statistics on the computation to standard error\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
@@ -271,15 +370,23 @@ int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, uselrs = false, quiet = false, eliminate = true;
+  int numThreads = 1;
+#if defined(_SC_NPROCESSORS_ONLN)
+  numThreads = std::max(1, (int) sysconf(_SC_NPROCESSORS_ONLN));
+#endif  // _SC_NPROCESSORS_ONLN
 
+  int printStats = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", 0, &printStats, 1 },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqcS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqcSt:", long_options, &long_opt_index)) != -1) {
     switch (c) {
+    case 0:
+      break;
     case 'v':
       PrintBanner(std::cerr); exit(1);
     case 'd':
@@ -298,6 +405,9 @@ int main(int argc, char *argv[])
     case 'c':
       g_showConnect = true;
       break;
+    case 't':
+      numThreads = std::max(1, atoi(optarg));
+      break;
     case 'S':
       break;
     case 'q':
@@ -334,7 +444,9 @@ int main(int argc, char *argv[])
   }
 
   try {
+    Statistics::BeginPhase("read");
     Game game = ReadGame(*input_stream);
+    Statistics::BeginPhase("solve");
     if (game->NumPlayers() != 2) {
       std::cerr << "Error: Game does not have two players.\n";
       return 1;
@@ -347,10 +459,14 @@ int main(int argc, char *argv[])
       LrsSolve(game);
     }
     else if (useFloat) {
-      Solve<double>(game);
+      // Floating-point tableaus cannot be searched concurrently
+      Solve<double>(game, 1);
     }
     else {
-      Solve<Rational>(game);
+      Solve<Rational>(game, numThreads);
+    }
+    if (printStats) {
+      Statistics::WriteJSON(std::cerr);
     }
     return 0;
   }
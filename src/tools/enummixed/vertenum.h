@@ -40,6 +40,14 @@
 // The code is based on the reverse Pivoting algorithm of Avis 
 // and Fukuda, Discrete Computational Geom (1992) 8:295-313.
 //
+// If more than one thread is requested, the top of the reverse search
+// tree is split into subtrees which are searched concurrently; the
+// vertices are reported in the same order as by the serial search.
+// This requires tableau copies to be independent of each other, which
+// holds for exact (Rational) tableaus only: floating-point tableaus
+// share their LU factorization workspace with the tableau they were
+// copied from.
+//
 
 template <class T> class VertEnum {
 private:
@@ -55,14 +63,24 @@ private:
   Gambit::List<Gambit::Vector<T> > Verts;
   long npivots,nodes;
   Gambit::List<long> visits,branches;
+  int m_numThreads;
+
+  class SearchTask;
+  class SearchPool;
+
+  // Constructs an empty enumerator to search subtrees on behalf of p_parent
+  VertEnum(const VertEnum<T> &p_parent, int);
 
   void Enum();
   void Deeper();
   void Report();
   void Search(LPTableau<T> &tab);
   void DualSearch(LPTableau<T> &tab);
+  void ParallelSearch(LPTableau<T> &tab);
+  static void *RunTasks(void *p_pool);
 public:
-  VertEnum(const Gambit::Matrix<T> &, const Gambit::Vector<T> &);
+  VertEnum(const Gambit::Matrix<T> &, const Gambit::Vector<T> &,
+	   int p_numThreads = 1);
   VertEnum(LPTableau<T> &);
   virtual ~VertEnum();
 
@@ -27,6 +27,7 @@
 #include <unistd.h>
 #include <getopt.h>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 #include "nfghs.h"
 
 int g_numDecimals = 6;
@@ -50,6 +51,7 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibrium probabilities with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          print statistics on the computation to standard error\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -H               use heuristic search method to optimize time\n";
   std::cerr << "                   to find first equilibrium (strategic games only)\n";
@@ -70,16 +72,20 @@ int main(int argc, char *argv[])
   bool quiet = false;
   bool useHeuristic = false, useStrategic = false;
 
+  int printStats = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
     { "verbose", 0, NULL, 'V'  },
+    { "stats", 0, &printStats, 1 },
     { 0,    0,    0,    0   }
   };
   int c;
   while ((c = getopt_long(argc, argv, "d:hHSqvV", long_options, &long_opt_index)) != -1) {
     switch (c) {
+    case 0:
+      break;
     case 'v':
       PrintBanner(std::cerr); exit(1);
     case 'd':
@@ -131,7 +137,9 @@ int main(int argc, char *argv[])
   }
 
   try {
+    Gambit::Statistics::BeginPhase("read");
     Gambit::Game game = Gambit::ReadGame(*input_stream);
+    Gambit::Statistics::BeginPhase("solve");
     if (!game->IsPerfectRecall()) {
       throw Gambit::UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
     }
@@ -148,6 +156,9 @@ int main(int argc, char *argv[])
     else {
       SolveExtensive(game);
     }
+    if (printStats) {
+      Gambit::Statistics::WriteJSON(std::cerr);
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
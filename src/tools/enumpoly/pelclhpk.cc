@@ -22,10 +22,10 @@ ALL RIGHTS RESERVED
 int HPK_cont(Dvector X, int tweak)
 {
     int i, ist, dst,N,N1;
-    static int iflag,trace,nfe,*pivot,*ipar;
-    static double *yold,*a,arcae;
-    static double *qr, arclen, *wp, *yp, *tz,*par,*z0,*z1;
-    static double ansre, *ypold, *sspar,*alpha,ansae,*w,*y,arcre;
+    int iflag,trace,nfe,*pivot,*ipar;
+    double *yold,*a,arcae;
+    double *qr, arclen, *wp, *yp, *tz,*par,*z0,*z1;
+    double ansre, *ypold, *sspar,*alpha,ansae,*w,*y,arcre;
     /* extern int fixpnf_(); IN Homotopies.h */
     
     if (Hom_defd!=1) return 0;
@@ -717,26 +717,78 @@ P ONLY. */
 /**********************************************************************/
 
 /*--------------------------------------------------------------------
- Workspace and Workspace management macros
+ Workspace and Workspace management
 -------------------------------------------------------------------*/
-#define TOPN 20       /*Assume no more than 20 variables*/
-#define TOPM 500      /* Assume no more than 500 monomials total*/
-static int Istore[TOPM*(TOPN+1)+3*TOPN+2+TOPM];
-static double Dstore[TOPM*2+12*(TOPN+1)+8+TOPN*(TOPN+2)+1];
-static int didx=0,iidx=0;
 
-/* initialization for storage  currently static should be
-   made dynamic*/
+/* the context used when none has been selected explicitly */
+static struct Hom_context_t Hom_default_context;
+static Hom_context Hom_cur=&Hom_default_context;
+
+Hom_context Hom_context_new(void)
+{
+  Hom_context c=(Hom_context)calloc(1,sizeof(struct Hom_context_t));
+  if (c==0) bad_error("malloc failed in Hom_context_new");
+  return c;
+}
+
+void Hom_context_free(Hom_context c)
+{
+  if (c==0 || c==&Hom_default_context) return;
+  if (Hom_cur==c) Hom_cur=&Hom_default_context;
+  free(c->istore);
+  free(c->dstore);
+  free(c);
+}
+
+Hom_context Hom_context_select(Hom_context c)
+{
+  Hom_context old=Hom_cur;
+  Hom_cur=(c!=0) ? c : &Hom_default_context;
+  return old;
+}
+
+Hom_context Hom_context_current(void) { return Hom_cur; }
+
+/* make sure the arenas of the current context can hold at least
+   isz ints and dsz doubles.  Must only be called while the arenas
+   are empty, as growing them invalidates outstanding pointers. */
+void Hom_context_reserve(int isz, int dsz)
+{
+  if (Hom_cur->iidx!=0 || Hom_cur->didx!=0) 
+    bad_error("Hom_context_reserve called on a busy workspace");
+  if (isz>Hom_cur->isize){
+    free(Hom_cur->istore);
+    Hom_cur->istore=(int *)malloc(isz*sizeof(int));
+    if (Hom_cur->istore==0) bad_error("malloc failed in Hom_context_reserve");
+    Hom_cur->isize=isz;
+  }
+  if (dsz>Hom_cur->dsize){
+    free(Hom_cur->dstore);
+    Hom_cur->dstore=(double *)malloc(dsz*sizeof(double));
+    if (Hom_cur->dstore==0) bad_error("malloc failed in Hom_context_reserve");
+    Hom_cur->dsize=dsz;
+  }
+}
 
 /* access funtions to double storage */
-double *Dres(int sz){ int v=didx; didx+=sz; return Dstore+v;}
-int Dtop(){return didx;}
-int Dfree(int ntop){ didx=ntop; return 0;}
+double *Dres(int sz){ 
+  int v=Hom_cur->didx; 
+  if (v+sz>Hom_cur->dsize) bad_error("double workspace exhausted in Dres");
+  Hom_cur->didx+=sz; 
+  return Hom_cur->dstore+v;
+}
+int Dtop(){return Hom_cur->didx;}
+int Dfree(int ntop){ Hom_cur->didx=ntop; return 0;}
 
 /* access funtions to int storage */
-int *Ires(int sz){ int v=iidx; iidx+=sz; return Istore+v;}
-int Itop(){return iidx;}
-int Ifree(int ntop){ iidx=ntop; return 0;}
+int *Ires(int sz){ 
+  int v=Hom_cur->iidx; 
+  if (v+sz>Hom_cur->isize) bad_error("int workspace exhausted in Ires");
+  Hom_cur->iidx+=sz; 
+  return Hom_cur->istore+v;
+}
+int Itop(){return Hom_cur->iidx;}
+int Ifree(int ntop){ Hom_cur->iidx=ntop; return 0;}
 
 /* end Hom_Mem.c */
 
@@ -3306,20 +3358,21 @@ to that used by hompack and described in Morgans book.
 -----------------------------------------------------------------*/
 
 /* parameters affecting the homotopy */
-int Hom_defd = 0;         /* 0 no homotopy initialized , 1 else*/
 int Hom_use_proj = 1;     /* 0 dont use proj trans, 1 else*/
-int Hom_num_vars = 0;     /* number of complex vars in curr hom*/
-
-/* private variables defining homotopy */
-static int NV,N,N1,M; 
-static int *Starting_Monomial; 
-static int *Number_of_Monomials;
-static int *Exponents; 
-static int *Hdegree;
-static int *Edegree;
-static double *Coefitients; 
-static int *Deformation; 
-static double *Proj_Trans;
+
+/* private variables defining homotopy, held in the current context */
+#define NV (Hom_cur->nv)
+#define N  (Hom_cur->n)
+#define N1 (Hom_cur->n1)
+#define M  (Hom_cur->m)
+#define Starting_Monomial   (Hom_cur->starting_monomial)
+#define Number_of_Monomials (Hom_cur->number_of_monomials)
+#define Exponents           (Hom_cur->exponents)
+#define Hdegree             (Hom_cur->hdegree)
+#define Edegree             (Hom_cur->edegree)
+#define Coefitients         (Hom_cur->coefitients)
+#define Deformation         (Hom_cur->deformation)
+#define Proj_Trans          (Hom_cur->proj_trans)
 
 /* index in monomial list (starting at 0) of equation i*/
 #define monst(i,j) ((Starting_Monomial[(i)-1])+(j)-1)
@@ -3401,6 +3454,15 @@ Hom_num_vars=NV;
 /* free all work space */
 Dfree(0); Ifree(0);
 
+/* size the workspace for the system data and for HPK_cont's arrays */
+M=0;
+for(i=0;i<NV;i++){
+    ptr=*PMref(P,1,i+1);
+    while(ptr!=0){M++; ptr=poly_next(ptr);}
+}
+Hom_context_reserve(3*NV+1+M*(NV+2)+1+N1,
+                    2*M+2*NV+2+11*N1+8+N*(N1+1)+1);
+
 /* count monomials in equations to initialize monst and Nmon*/
 Starting_Monomial=Ires(NV+1);
 Number_of_Monomials=Ires(NV);
@@ -3412,7 +3474,6 @@ for(i=0;i<NV;i++){
     Starting_Monomial[i+1]=
               Starting_Monomial[i]+Number_of_Monomials[i];
 }
-M=Starting_Monomial[NV];
 
 Exponents=Ires(NV*M);
 Coefitients=Dres(M*2);
@@ -3652,6 +3713,19 @@ if(Hom_use_proj==1) c=Cmul(c,Cpow(PN,Hdeg(i,j)));
 return 0;
 }
 
+#undef NV
+#undef N
+#undef N1
+#undef M
+#undef Starting_Monomial
+#undef Number_of_Monomials
+#undef Exponents
+#undef Hdegree
+#undef Edegree
+#undef Coefitients
+#undef Deformation
+#undef Proj_Trans
+
 /* end, original Homotopies.c */
 
 
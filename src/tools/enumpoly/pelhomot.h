@@ -37,10 +37,8 @@ subdirectory of the source directory of the original Pelican 0.80
 
 #define Hom_LogFile stdout /* was Pel_Log */
 #define Hom_OutFile stdout /* was Pel_Out */
-extern int     Hom_defd; 
 extern int     Hom_use_proj;
 extern int     Hom_use_scale;
-extern int     Hom_num_vars;
 extern char    Hom_LogName[];
 extern FILE   *Pel_Log;
 extern FILE   *Pel_Out;
@@ -55,6 +53,43 @@ void print_Hom_params(FILE *);
 /****************** header information from Hom_Mem.h *******************/
 /************************************************************************/
 
+/*
+** A homotopy context holds everything defining one homotopy: the real
+** form of the system being tracked, and the int and double arenas
+** from which Ires/Dres hand out work space.  The arenas are sized by
+** init_hom() for the system at hand, so there is no fixed limit on the
+** number of variables or monomials.  All of the functions below, as well
+** as init_hom() and HPK_cont(), operate on the currently selected context.
+*/
+struct Hom_context_t {
+  int     defd;         /* 0 no homotopy initialized, 1 else */
+  int     num_vars;     /* number of complex vars in the homotopy */
+
+  int     nv, n, n1, m;
+  int    *starting_monomial;
+  int    *number_of_monomials;
+  int    *exponents;
+  int    *hdegree;
+  int    *edegree;
+  double *coefitients;
+  int    *deformation;
+  double *proj_trans;
+
+  int    *istore;
+  int     isize, iidx;
+  double *dstore;
+  int     dsize, didx;
+};
+
+Hom_context Hom_context_new(void);
+void        Hom_context_free(Hom_context);
+Hom_context Hom_context_select(Hom_context); /* returns previous context */
+Hom_context Hom_context_current(void);
+void        Hom_context_reserve(int isz, int dsz);
+
+#define Hom_defd     (Hom_context_current()->defd)
+#define Hom_num_vars (Hom_context_current()->num_vars)
+
 double *Dres(int);
 int Dtop();                                    
 int Dfree(int ntop);
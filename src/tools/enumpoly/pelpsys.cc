@@ -1255,11 +1255,16 @@ node psys_hom(psys sys, node point_list, int tweak){
 #endif
 
   if (Cont_Alg==USE_HOMPACK){
+     /* each continuation gets a workspace of its own */
+     Hom_context hom=Hom_context_new();
+     Hom_context prev=Hom_context_select(hom);
      init_hom(sys);
      while(ptr!=0){
        HPK_cont((Dmatrix)Car(Car(ptr)), tweak);
        ptr=Cdr(ptr);
      }
+     Hom_context_select(prev);
+     Hom_context_free(hom);
   }
   else {
     while(ptr!=0){
@@ -38,6 +38,10 @@ http://netlib2.cs.utk.edu/hompack/
 typedef struct psys_t *psys;
 
 /* These declarations are added to get compilation.  Linking is another matter... */
+typedef struct Hom_context_t *Hom_context;
+Hom_context Hom_context_new(void);
+void Hom_context_free(Hom_context);
+Hom_context Hom_context_select(Hom_context);
 int HPK_cont(Dvector, int tweak);
 int init_hom(psys);
 
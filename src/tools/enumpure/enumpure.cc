@@ -21,11 +21,13 @@
 //
 
 #include <cstdlib>
+#include <algorithm>
 #include <getopt.h>
 #include <unistd.h>
 #include <iostream>
 #include <fstream>
 #include <cerrno>
+#include "libgambit/stats.h"
 #include "enumpure.h"
 
 
@@ -47,7 +49,9 @@ void PrintHelp(char *progname)
   std::cerr << "  -S               report equilibria in strategies even for extensive games\n";
   std::cerr << "  -A               compute agent form equilibria\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -t THREADS       number of threads to use for solving subgames\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          print statistics on the computation to standard error\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
@@ -60,15 +64,23 @@ int main(int argc, char *argv[])
   bool quiet = false, reportStrategic = false, solveAgent = false, bySubgames = false;
   bool printDetail = false;
   
+  int numThreads = 1;
+#if defined(_SC_NPROCESSORS_ONLN)
+  numThreads = std::max(1, (int) sysconf(_SC_NPROCESSORS_ONLN));
+#endif  // _SC_NPROCESSORS_ONLN
+  int printStats = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", 0, &printStats, 1 },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "DvhqASP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "DvhqASPt:", long_options, &long_opt_index)) != -1) {
     switch (c) {
+    case 0:
+      break;
     case 'v':
       PrintBanner(std::cerr); exit(1);
     case 'D':
@@ -83,6 +95,9 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 't':
+      numThreads = std::max(1, atoi(optarg));
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -120,7 +135,9 @@ int main(int argc, char *argv[])
   }
 
   try {
+    Gambit::Statistics::BeginPhase("read");
     Game game = ReadGame(*input_stream);
+    Gambit::Statistics::BeginPhase("solve");
     shared_ptr<StrategyProfileRenderer<Rational> > renderer;
     if (reportStrategic || !game->IsTree()) {
       if (printDetail) {
@@ -150,7 +167,7 @@ int main(int argc, char *argv[])
 	    new NashEnumPureStrategySolver();
 	  stage = new NashBehavViaStrategySolver<Rational>(substage);
 	}
-	SubgameNashBehavSolver<Rational> algorithm(stage, renderer);
+	SubgameNashBehavSolver<Rational> algorithm(stage, renderer, numThreads);
 	algorithm.Solve(game);
       }
       else {
@@ -168,6 +185,9 @@ int main(int argc, char *argv[])
       NashEnumPureStrategySolver algorithm(renderer);
       algorithm.Solve(game);
     }
+    if (printStats) {
+      Gambit::Statistics::WriteJSON(std::cerr);
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
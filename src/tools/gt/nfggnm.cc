@@ -27,6 +27,7 @@
 #include <fstream>
 #include <cerrno>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 
 #include "nfgame.h"
 #include "aggame.h"
@@ -87,6 +88,7 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          print statistics on the computation to standard error\n";
   std::cerr << "  -n COUNT         number of perturbation vectors to generate\n";
   std::cerr << "  -s FILE          file containing perturbation vectors\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -184,16 +186,20 @@ int main(int argc, char *argv[])
   opterr = 0;
   bool quiet = false;
 
+  int printStats = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
     { "verbose", 0, NULL, 'V'  },
+    { "stats", 0, &printStats, 1 },
     { 0,    0,    0,    0   }
   };
   int c;
   while ((c = getopt_long(argc, argv, "d:n:s:qvVhS", long_options, &long_opt_index)) != -1) {
     switch (c) {
+    case 0:
+      break;
     case 'v':
       PrintBanner(std::cerr); exit(1);
     case 'q':
@@ -247,11 +253,16 @@ int main(int argc, char *argv[])
   }
 
   try {
+    Gambit::Statistics::BeginPhase("read");
     Gambit::Game game = Gambit::ReadGame(*input_stream);
+    Gambit::Statistics::BeginPhase("solve");
     if (!game->IsPerfectRecall()) {
       throw Gambit::UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
     }
     Solve(game);
+    if (printStats) {
+      Gambit::Statistics::WriteJSON(std::cerr);
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
@@ -23,10 +23,12 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
+#include <algorithm>
 #include <cerrno>
 #include <unistd.h>
 #include <getopt.h>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 #include "efglcp.h"
 #include "nfglcp.h"
 
@@ -51,12 +53,14 @@ void PrintHelp(char *progname)
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -t THREADS       number of threads to use for solving subgames\n";
   std::cerr << "  -e EQA           terminate after finding EQA equilibria\n";
   std::cerr << "                   (default is to find all accessible equilbria\n";
   std::cerr << "  -r DEPTH         terminate recursion at DEPTH\n";
   std::cerr << "                   (only if number of equilibria sought is not 1)\n";
   std::cerr << "  -D               print detailed information about equilibria\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          print statistics on the computation to standard error\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
@@ -70,14 +74,22 @@ int main(int argc, char *argv[])
   bool printDetail = false;
   int numDecimals = 6, stopAfter = 0, maxDepth = 0;
 
+  int numThreads = 1;
+#if defined(_SC_NPROCESSORS_ONLN)
+  numThreads = std::max(1, (int) sysconf(_SC_NPROCESSORS_ONLN));
+#endif  // _SC_NPROCESSORS_ONLN
+  int printStats = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", 0, &printStats, 1 },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:t:", long_options, &long_opt_index)) != -1) {
     switch (c) {
+    case 0:
+      break;
     case 'v':
       PrintBanner(std::cerr); exit(1);
     case 'd':
@@ -105,6 +117,9 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 't':
+      numThreads = std::max(1, atoi(optarg));
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -136,7 +151,9 @@ int main(int argc, char *argv[])
   }
 
   try {
+    Statistics::BeginPhase("read");
     Game game = ReadGame(*input_stream);
+    Statistics::BeginPhase("solve");
     if (!game->IsTree() || useStrategic) {
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
@@ -204,7 +221,7 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<double>(std::cout, 
 							    numDecimals);
 	  }
-	  SubgameNashBehavSolver<double> algorithm(stage, renderer);
+	  SubgameNashBehavSolver<double> algorithm(stage, renderer, numThreads);
 	  algorithm.Solve(game);
 	}
 	else {
@@ -219,11 +236,14 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout, 
 							      numDecimals);
 	  }
-	  SubgameNashBehavSolver<Rational> algorithm(stage, renderer);
+	  SubgameNashBehavSolver<Rational> algorithm(stage, renderer, numThreads);
 	  algorithm.Solve(game);
 	}
       }
     }
+    if (printStats) {
+      Statistics::WriteJSON(std::cerr);
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
@@ -28,6 +28,11 @@
 template <class T> class LTableau : public Tableau<T> {
 protected:
 //  T eps2;
+
+  // Resolves ties among the candidate rows of a ratio test
+  int BreakTies(Gambit::Array<int> &p_candidates,
+		const Gambit::Vector<T> &p_incol, bool p_minimize);
+
 public:
 //   LTableau(void);
   class BadPivot : public Gambit::Exception  {
@@ -27,6 +27,7 @@
 #include <unistd.h>
 #include <getopt.h>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 #include "efgliap.h"
 #include "nfgliap.h"
 
@@ -49,6 +50,7 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      print probabilities with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          print statistics on the computation to standard error\n";
   std::cerr << "  -n COUNT         number of starting points to generate\n";
   std::cerr << "  -s FILE          file containing starting points\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -140,16 +142,20 @@ int main(int argc, char *argv[])
   double tolN = 1.0e-10;
   std::string startFile = "";
  
+  int printStats = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
     { "verbose", 0, NULL, 'V'  },
+    { "stats", 0, &printStats, 1 },
     { 0,    0,    0,    0   }
   };
   int c;
   while ((c = getopt_long(argc, argv, "d:n:s:hqVvS", long_options, &long_opt_index)) != -1) {
     switch (c) {
+    case 0:
+      break;
     case 'v':
       PrintBanner(std::cerr); exit(1);
     case 'd':
@@ -204,7 +210,9 @@ int main(int argc, char *argv[])
   }
 
   try {
+    Statistics::BeginPhase("read");
     Game game = ReadGame(*input_stream);
+    Statistics::BeginPhase("solve");
     if (!game->IsTree() || useStrategic) {
       List<MixedStrategyProfile<double> > starts;
       if (startFile != "") {
@@ -243,6 +251,9 @@ int main(int argc, char *argv[])
 	algorithm.Solve(starts[i]);
       }
     }
+    if (printStats) {
+      Statistics::WriteJSON(std::cerr);
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
@@ -147,6 +147,10 @@ void RatioEquation::Gradient(const LogBehavProfile<double> &p_profile,
 			     double p_lambda,
 			     Vector<double> &p_gradient)
 {
+  DVector<double> derivs(m_game->NumActions()), derivs1(m_game->NumActions());
+  p_profile.DiffActionValues(m_infoset->GetAction(m_act), derivs);
+  p_profile.DiffActionValues(m_infoset->GetAction(1), derivs1);
+
   int i = 1;
   for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
     GamePlayer player = m_game->GetPlayer(pl);
@@ -165,12 +169,8 @@ void RatioEquation::Gradient(const LogBehavProfile<double> &p_profile,
 	  }
 	}
 	else {   // infoset1 != infoset2
-	  p_gradient[i] = 
-	    -p_lambda * 
-	    (p_profile.DiffActionValue(m_infoset->GetAction(m_act),
-				       infoset->GetAction(act)) -
-	     p_profile.DiffActionValue(m_infoset->GetAction(1),
-				       infoset->GetAction(act)));
+	  p_gradient[i] = -p_lambda * (derivs(pl, iset, act) - 
+				       derivs1(pl, iset, act));
 	}
       }
     }
@@ -80,6 +80,7 @@ protected:
   /// @name Auxiliary functions for computation of interesting values
   //@{
   void GetPayoff(GameTreeNodeRep *, const T &, int, T &) const;
+  void DiffNodeValues(const GameNode &, int, const T &, DVector<T> &) const;
   
   void ComputeSolutionDataPass2(const GameNode &node) const;
   void ComputeSolutionDataPass1(const GameNode &node) const;
@@ -195,6 +196,8 @@ public:
 		   const GameAction &oppAction) const;
   T DiffNodeValue(const GameNode &node, const GamePlayer &player,
 		  const GameAction &oppAction) const;
+  void DiffActionValues(const GameAction &action,
+			DVector<T> &derivs) const;
 
   //@}
 };
@@ -28,6 +28,7 @@
 #include <unistd.h>
 #include <getopt.h>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 #include "efglogit.h"
 #include "nfglogit.h"
 
@@ -55,6 +56,7 @@ void PrintHelp(char *progname)
   std::cerr << "  -L FILE          compute maximum likelihood estimates;\n";
   std::cerr << "                   read strategy frequencies from FILE\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          print statistics on the computation to standard error\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -e               print only the terminal equilibrium\n";
   std::cerr << "                   (default is to print the entire branch)\n";
@@ -98,15 +100,19 @@ int main(int argc, char *argv[])
   bool fullGraph = true;
   int decimals = 6;
 
+  int printStats = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", 0, &printStats, 1 },
     { 0,    0,    0,    0   }
   };
   int c;
   while ((c = getopt_long(argc, argv, "d:s:a:m:vqehSL:p:l:", long_options, &long_opt_index)) != -1) {
     switch (c) {
+    case 0:
+      break;
     case 'v':
       PrintBanner(std::cerr); exit(1);
     case 'q':
@@ -174,7 +180,9 @@ int main(int argc, char *argv[])
 
   try {
     Gambit::Array<double> frequencies;
+    Gambit::Statistics::BeginPhase("read");
     Gambit::Game game = Gambit::ReadGame(*input_stream);
+    Gambit::Statistics::BeginPhase("solve");
     if (!game->IsPerfectRecall()) {
       throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
     }
@@ -233,6 +241,9 @@ int main(int argc, char *argv[])
       tracer.SetDecimals(decimals);
       tracer.TraceAgentPath(start, 0.0, maxLambda, 1.0);
     }
+    if (printStats) {
+      Gambit::Statistics::WriteJSON(std::cerr);
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
@@ -120,17 +120,27 @@ StrategicQREPathTracer::GetJacobian(const Vector<double> &p_point,
 				    Matrix<double> &p_matrix)
 {
   const Game &game = m_start.GetGame();
-  MixedStrategyProfile<double> profile(game->NewMixedStrategyProfile(0.0)), logprofile(game->NewMixedStrategyProfile(0.0));
+  MixedStrategyProfile<double> profile(game->NewMixedStrategyProfile(0.0));
   for (int i = 1; i <= profile.MixedProfileLength(); i++) {
     profile[i] = exp(p_point[i]);
-    logprofile[i] = p_point[i];
   }
   double lambda = p_point[p_point.Length()];
 
   p_matrix = 0.0;
 
+  // The second derivatives of each player's payoff, computed in one
+  // pass over the game for each player.  Rows and columns are indexed
+  // in the same order as the columns of the Jacobian.
+  Matrix<double> hessian(profile.MixedProfileLength(), 
+			 profile.MixedProfileLength());
+
   for (int rowno = 0, i = 1; i <= game->NumPlayers(); i++) {
     GamePlayer player = game->Players()[i];
+    // Row (and position in profile) of the player's first strategy
+    int firstrow = rowno + 1;
+    if (player->Strategies().size() > 1) {
+      profile.GetPayoffHessian(i, hessian);
+    }
     for (int j = 1; j <= player->Strategies().size(); j++) {
       rowno++;
       if (j == 1) {
@@ -165,12 +175,7 @@ StrategicQREPathTracer::GetJacobian(const Vector<double> &p_point,
 	    else {
 	      p_matrix(colno, rowno) =
 		-lambda * profile[player2->GetStrategy(m)] *
-		(profile.GetPayoffDeriv(i, 
-					player->GetStrategy(j),
-					player2->GetStrategy(m)) -
-		 profile.GetPayoffDeriv(i, 
-					player->GetStrategy(1),
-					player2->GetStrategy(m)));
+		(hessian(rowno, colno) - hessian(firstrow, colno));
 	    }
 	  }
 	}
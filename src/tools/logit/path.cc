@@ -26,6 +26,7 @@
 
 #include <libgambit/libgambit.h>
 #include <libgambit/sqmatrix.h>
+#include <libgambit/stats.h>
 using namespace Gambit;
 
 #include "path.h"
@@ -53,18 +54,24 @@ static void Givens(Matrix<double> &b, Matrix<double> &q,
   double s1 = c1/sn;
   double s2 = c2/sn;
 
-  for (int k = 1; k <= q.NumColumns(); k++) {
-    double sv1 = q(l1, k);
-    double sv2 = q(l2, k);
-    q(l1, k) = s1 * sv1 + s2 * sv2;
-    q(l2, k) = -s2 * sv1 + s1 * sv2;
+  // Matrix rows are contiguous, so the rotation is applied directly
+  // to the two rows, avoiding bounds-checked indexing in the inner loops
+  double *q1 = &q(l1, 1), *q2 = &q(l2, 1);
+  for (int k = 0; k < q.NumColumns(); k++) {
+    double sv1 = q1[k];
+    double sv2 = q2[k];
+    q1[k] = s1 * sv1 + s2 * sv2;
+    q2[k] = -s2 * sv1 + s1 * sv2;
   }
 
-  for (int k = l3; k <= b.NumColumns(); k++) {
-    double sv1 = b(l1, k);
-    double sv2 = b(l2, k);
-    b(l1, k) = s1 * sv1 + s2 * sv2;
-    b(l2, k) = -s2 * sv1 + s1 * sv2;
+  if (l3 <= b.NumColumns()) {
+    double *b1 = &b(l1, l3), *b2 = &b(l2, l3);
+    for (int k = 0; k <= b.NumColumns() - l3; k++) {
+      double sv1 = b1[k];
+      double sv2 = b2[k];
+      b1[k] = s1 * sv1 + s2 * sv2;
+      b2[k] = -s2 * sv1 + s1 * sv2;
+    }
   }
 
   c1 = sn;
@@ -92,14 +99,23 @@ static void NewtonStep(Matrix<double> &q, Matrix<double> &b,
     y[k] /= b(k, k);
   }
 
+  // Accumulate the transpose product s = q^T y a row of q at a time,
+  // which keeps the access pattern along the contiguous rows of q
+  Vector<double> s(b.NumRows());
+  s = 0.0;
+  double *sk = &s[1];
+  for (int l = 1; l <= b.NumColumns(); l++) {
+    const double *ql = &q(l, 1);
+    double yl = y[l];
+    for (int k = 0; k < b.NumRows(); k++) {
+      sk[k] += ql[k] * yl;
+    }
+  }
+
   d = 0.0;
   for (int k = 1; k <= b.NumRows(); k++) {
-    double s = 0.0;
-    for (int l = 1; l <= b.NumColumns(); l++) {
-      s += q(l, k) * y[l];
-    }
-    u[k] -= s;
-    d += s * s;
+    u[k] -= s[k];
+    d += s[k] * s[k];
   }
   d = sqrt(d);
 }
@@ -196,6 +212,7 @@ PathTracer::TracePath(Vector<double> &x,
     }
 
     if (!accept) {
+      Statistics::Count(Statistics::PathRejections);
       h /= m_maxDecel;   // PC not accepted; change stepsize and retry
       if (fabs(h) <= c_hmin) {
 	OnStep(x, true);
@@ -233,6 +250,7 @@ PathTracer::TracePath(Vector<double> &x,
     }
 
     // PC step was successful; update and iterate
+    Statistics::Count(Statistics::PathSteps);
     x = u;
     OnStep(x, false);
 
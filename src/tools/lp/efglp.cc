@@ -25,6 +25,7 @@
 #include <iostream>
 #include "libgambit/libgambit.h"
 #include "liblinear/lpsolve.h"
+#include "liblinear/sparselp.h"
 #include "efglp.h"
 
 using namespace Gambit;
@@ -39,7 +40,7 @@ public:
   GameData(const BehaviorSupportProfile &);
 
   void BuildConstraintMatrix(const BehaviorSupportProfile &,
-			     Matrix<T> &, const GameNode &, const T &,
+			     SparseMatrix<T> &, const GameNode &, const T &,
 			     int, int, int, int);
   void GetBehavior(const BehaviorSupportProfile &, MixedBehaviorProfile<T> &v,
 		   const Array<T> &, const Array<T> &,
@@ -80,7 +81,7 @@ NashLpBehavSolver<T>::GameData::GameData(const BehaviorSupportProfile &p_support
 //
 template <class T> void
 NashLpBehavSolver<T>::GameData::BuildConstraintMatrix(const BehaviorSupportProfile &p_support,
-						      Matrix<T> &A, 
+						      SparseMatrix<T> &A, 
 						      const GameNode &n, 
 						      const T &prob,
 						      int s1, int s2, 
@@ -140,42 +141,50 @@ NashLpBehavSolver<T>::GameData::BuildConstraintMatrix(const BehaviorSupportProfi
 // similarly, the array p_dual should have the same length as the
 // number of rows in A, and the routine returns the dual solution.
 //
+// The sequence form has only a few nonzeros in each column, so the
+// problem is first given to the sparse solver.  Should it fail, or its
+// solution not check out exactly, the dense solver is used instead.
+//
 // To implement your own custom solver for this problem, simply
 // replace this function.
 //
 template <class T> bool
-NashLpBehavSolver<T>::SolveLP(const Matrix<T> &A, 
+NashLpBehavSolver<T>::SolveLP(const SparseMatrix<T> &A, 
 			      const Vector<T> &b, const Vector<T> &c,
 			      int nequals,
 			      Array<T> &p_primal, Array<T> &p_dual) const
 {
-  LPSolve<T> LP(A, b, c, nequals);
-  if (!LP.IsAborted()) {
-    BFS<T> cbfs;
+  BFS<T> cbfs;
+  SparseLPSolve<T> sparse(A, b, c, nequals);
+  if (!sparse.IsAborted()) {
+    sparse.OptBFS(cbfs);
+  }
+  else {
+    LPSolve<T> LP(A.GetDense(), b, c, nequals);
+    if (LP.IsAborted()) {
+      return false;
+    }
     LP.OptBFS(cbfs);
+  }
 
-    for (int i = 1; i <= A.NumColumns(); i++) {
-      if (cbfs.count(i)) {
-	p_primal[i] = cbfs[i];
-      }
-      else {
-	p_primal[i] = (T) 0;
-      }
+  for (int i = 1; i <= A.NumColumns(); i++) {
+    if (cbfs.count(i)) {
+      p_primal[i] = cbfs[i];
     }
-
-    for (int i = 1; i <= A.NumRows(); i++) {
-      if (cbfs.count(-i)) {
-	p_dual[i] = cbfs[-i];
-      }
-      else {
-	p_dual[i] = (T) 0;
-      }
+    else {
+      p_primal[i] = (T) 0;
     }
-    return true;
   }
-  else {
-    return false;
+
+  for (int i = 1; i <= A.NumRows(); i++) {
+    if (cbfs.count(-i)) {
+      p_dual[i] = cbfs[-i];
+    }
+    else {
+      p_dual[i] = (T) 0;
+    }
   }
+  return true;
 }
 
 //
@@ -258,11 +267,10 @@ NashLpBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   
   GameData data(p_support.GetGame());
 
-  Matrix<T> A(1, data.ns1 + data.ni2, 1, data.ns2 + data.ni1);
+  SparseMatrix<T> A(data.ns1 + data.ni2, data.ns2 + data.ni1);
   Vector<T> b(1, data.ns1 + data.ni2);
   Vector<T> c(1, data.ns2 + data.ni1);
 
-  A = (T) 0;
   b = (T) 0;
   c = (T) 0;
 
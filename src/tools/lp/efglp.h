@@ -24,6 +24,7 @@
 #define LP_EFGLP_H
 
 #include "libgambit/nash.h"
+#include "liblinear/sparsemat.h"
 
 using namespace Gambit;
 
@@ -38,7 +39,7 @@ public:
 private:
   class GameData;
 
-  virtual bool SolveLP(const Matrix<T> &, const Vector<T> &, const Vector<T> &,
+  virtual bool SolveLP(const SparseMatrix<T> &, const Vector<T> &, const Vector<T> &,
 		       int, Array<T> &, Array<T> &) const;
 };
 
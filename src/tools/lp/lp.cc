@@ -25,9 +25,11 @@
 #include <fstream>
 #include <cerrno>
 #include <cstdlib>
+#include <algorithm>
 #include <unistd.h>
 #include <getopt.h>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 #include "efglp.h"
 #include "nfglp.h"
 
@@ -53,7 +55,9 @@ void PrintHelp(char *progname)
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -t THREADS       number of threads to use for solving subgames\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          print statistics on the computation to standard error\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
@@ -66,14 +70,22 @@ int main(int argc, char *argv[])
   bool useFloat = false, useStrategic = false, quiet = false, printDetail = false;
   bool bySubgames = false;
 
+  int numThreads = 1;
+#if defined(_SC_NPROCESSORS_ONLN)
+  numThreads = std::max(1, (int) sysconf(_SC_NPROCESSORS_ONLN));
+#endif  // _SC_NPROCESSORS_ONLN
+  int printStats = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", 0, &printStats, 1 },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvqhSP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvqhSPt:", long_options, &long_opt_index)) != -1) {
     switch (c) {
+    case 0:
+      break;
     case 'v':
       PrintBanner(std::cerr); exit(1);
     case 'd':
@@ -95,6 +107,9 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 't':
+      numThreads = std::max(1, atoi(optarg));
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -126,7 +141,9 @@ int main(int argc, char *argv[])
   }
 
   try {
+    Statistics::BeginPhase("read");
     Gambit::Game game = Gambit::ReadGame(*input_stream);
+    Statistics::BeginPhase("solve");
     if (!game->IsTree() || useStrategic) {
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
@@ -192,7 +209,7 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<double>(std::cout, 
 							    numDecimals);
 	  }
-	  SubgameNashBehavSolver<double> algorithm(stage, renderer);
+	  SubgameNashBehavSolver<double> algorithm(stage, renderer, numThreads);
 	  algorithm.Solve(game);
 	}
 	else {
@@ -207,11 +224,14 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout, 
 							      numDecimals);
 	  }
-	  SubgameNashBehavSolver<Rational> algorithm(stage, renderer);
+	  SubgameNashBehavSolver<Rational> algorithm(stage, renderer, numThreads);
 	  algorithm.Solve(game);
 	}
       }
     }
+    if (printStats) {
+      Statistics::WriteJSON(std::cerr);
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
@@ -0,0 +1,288 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/random/random.cc
+// Generate random games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "libgambit/libgambit.h"
+#include "libgambit/gamegen.h"
+
+using namespace Gambit;
+
+void PrintBanner(std::ostream &p_stream)
+{
+  p_stream << "Generate random games\n";
+  p_stream << "Gambit version " VERSION ", Copyright (C) 1994-2014, The Gambit Project\n";
+  p_stream << "This is free software, distributed under the GNU GPL\n\n";
+}
+
+void PrintHelp(char *progname)
+{
+  PrintBanner(std::cerr);
+  std::cerr << "Usage: " << progname << " [OPTIONS] [DIMENSIONS]\n";
+  std::cerr << "Writes a randomly generated game to standard output.\n";
+  std::cerr << "For strategic games, DIMENSIONS gives the number of strategies\n";
+  std::cerr << "of each player, as in 3x3x2 (default is 2x2).\n\n";
+
+  std::cerr << "Options:\n";
+  std::cerr << "  -t TYPE          type of game to generate (default is random):\n";
+  std::cerr << "     TYPE=random        payoffs drawn uniformly\n";
+  std::cerr << "     TYPE=zerosum       zero-sum game\n";
+  std::cerr << "     TYPE=covariant     normal payoffs with correlation given by -r\n";
+  std::cerr << "     TYPE=coordination  common payoffs when all choose the same strategy\n";
+  std::cerr << "     TYPE=congestion    congestion game; strategies are facilities\n";
+  std::cerr << "     TYPE=sparse        outcomes shared among contingencies\n";
+  std::cerr << "     TYPE=tree          extensive game\n";
+  std::cerr << "  -s SEED          seed for the random number generator (default 1)\n";
+  std::cerr << "  -m MAXPAYOFF     largest payoff, or scale for covariant (default 100)\n";
+  std::cerr << "  -r CORRELATION   correlation of payoffs for covariant (default 0)\n";
+  std::cerr << "  -o OUTCOMES      number of distinct outcomes for sparse (default 100)\n";
+  std::cerr << "  -p DENSITY       fraction of contingencies with an outcome\n";
+  std::cerr << "                   for sparse (default 1)\n";
+  std::cerr << "  -n PLAYERS       number of players in tree (default 2)\n";
+  std::cerr << "  -d DEPTH         depth of tree (default 4)\n";
+  std::cerr << "  -b BRANCHING     number of actions at each move of tree (default 2)\n";
+  std::cerr << "  -I               generate tree with perfect information\n";
+  std::cerr << "  -z               generate tree with zero-sum payoffs\n";
+  std::cerr << "  -c COUNT         generate COUNT games, with seeds SEED, SEED+1, ...\n";
+  std::cerr << "  -w DIR           write games to files in DIR, instead of to\n";
+  std::cerr << "                   standard output\n";
+  std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -q               quiet mode (suppresses banner)\n";
+  std::cerr << "  -v, --version    print version information\n";
+  exit(1);
+}
+
+//
+// Parses dimensions written as, for example, 3x3x2.  Returns false if
+// the text is not of this form.
+//
+bool ParseDimensions(const std::string &p_text, Array<int> &p_dim)
+{
+  std::string::size_type start = 0;
+  while (true) {
+    std::string::size_type end = p_text.find('x', start);
+    std::string field = p_text.substr(start, (end == std::string::npos) ?
+				      std::string::npos : end - start);
+    if (field.empty() ||
+	field.find_first_not_of("0123456789") != std::string::npos) {
+      return false;
+    }
+    p_dim.Append(atoi(field.c_str()));
+    if (end == std::string::npos)  return true;
+    start = end + 1;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  int c;
+  bool quiet = false, perfectInfo = false, zeroSum = false;
+  std::string type = "random", gameDir;
+  unsigned long seed = 1;
+  int maxPayoff = 100, outcomes = 100, players = 2, depth = 4, branching = 2;
+  int count = 1;
+  double correlation = 0.0, density = 1.0;
+
+  int long_opt_index = 0;
+  struct option long_options[] = {
+    { "help", 0, NULL, 'h'   },
+    { "version", 0, NULL, 'v'  },
+    { 0,    0,    0,    0   }
+  };
+  while ((c = getopt_long(argc, argv, "t:s:m:r:o:p:n:d:b:Izc:w:vhq",
+			  long_options, &long_opt_index)) != -1) {
+    switch (c) {
+    case 'v':
+      PrintBanner(std::cerr); exit(1);
+    case 't':
+      type = optarg;
+      break;
+    case 's':
+      seed = strtoul(optarg, 0, 10);
+      break;
+    case 'm':
+      maxPayoff = atoi(optarg);
+      break;
+    case 'r':
+      correlation = atof(optarg);
+      break;
+    case 'o':
+      outcomes = atoi(optarg);
+      break;
+    case 'p':
+      density = atof(optarg);
+      break;
+    case 'n':
+      players = atoi(optarg);
+      break;
+    case 'd':
+      depth = atoi(optarg);
+      break;
+    case 'b':
+      branching = atoi(optarg);
+      break;
+    case 'I':
+      perfectInfo = true;
+      break;
+    case 'z':
+      zeroSum = true;
+      break;
+    case 'c':
+      count = atoi(optarg);
+      break;
+    case 'w':
+      gameDir = optarg;
+      break;
+    case 'h':
+      PrintHelp(argv[0]);
+      break;
+    case 'q':
+      quiet = true;
+      break;
+    case '?':
+      if (isprint(optopt)) {
+	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
+      }
+      else {
+	std::cerr << argv[0] << ": Unknown option character `\\x" << optopt << "`.\n";
+      }
+      return 1;
+    default:
+      abort();
+    }
+  }
+
+  if (!quiet) {
+    PrintBanner(std::cerr);
+  }
+
+  if (type != "random" && type != "zerosum" && type != "covariant" &&
+      type != "coordination" && type != "congestion" && type != "sparse" &&
+      type != "tree") {
+    std::cerr << argv[0] << ": Unknown game type '" << type << "'.\n";
+    return 1;
+  }
+
+  Array<int> dim;
+  if (optind < argc) {
+    if (type == "tree") {
+      std::cerr << argv[0] << ": Dimensions do not apply to trees.\n";
+      return 1;
+    }
+    if (!ParseDimensions(argv[optind], dim)) {
+      std::cerr << argv[0] << ": Invalid dimensions '" << argv[optind] << "'.\n";
+      return 1;
+    }
+  }
+  else {
+    dim.Append(2);
+    dim.Append(2);
+  }
+  if (type == "congestion") {
+    for (int pl = 2; pl <= dim.Length(); pl++) {
+      if (dim[pl] != dim[1]) {
+	std::cerr << argv[0] << ": Players in a congestion game must have the same number of strategies.\n";
+	return 1;
+      }
+    }
+  }
+
+  if (count < 1) {
+    std::cerr << argv[0] << ": Number of games must be positive.\n";
+    return 1;
+  }
+  if (count > 1 && gameDir == "") {
+    std::cerr << argv[0] << ": Writing more than one game requires -w.\n";
+    return 1;
+  }
+  if (gameDir != "") {
+    struct stat info;
+    if (stat(gameDir.c_str(), &info) != 0) {
+#if defined(_WIN32)
+      mkdir(gameDir.c_str());
+#else
+      mkdir(gameDir.c_str(), 0777);
+#endif  // _WIN32
+    }
+  }
+
+  try {
+    for (int i = 0; i < count; i++) {
+      GameRandom random(seed + i);
+      Game game;
+      if (type == "random") {
+	game = RandomTableGame(dim, random, maxPayoff);
+      }
+      else if (type == "zerosum") {
+	game = ZeroSumTableGame(dim, random, maxPayoff);
+      }
+      else if (type == "covariant") {
+	game = CovariantTableGame(dim, correlation, random, maxPayoff);
+      }
+      else if (type == "coordination") {
+	game = CoordinationTableGame(dim, random, maxPayoff);
+      }
+      else if (type == "congestion") {
+	game = CongestionTableGame(dim.Length(), dim[1], random, maxPayoff);
+      }
+      else if (type == "sparse") {
+	game = SparseTableGame(dim, outcomes, density, random, maxPayoff);
+      }
+      else {
+	game = RandomTreeGame(players, depth, branching, perfectInfo, zeroSum,
+			      random, maxPayoff);
+      }
+
+      std::ostringstream title;
+      title << "Random " << type << " game, seed " << (seed + i);
+      game->SetTitle(title.str());
+
+      if (gameDir == "") {
+	game->Write(std::cout);
+	continue;
+      }
+      std::ostringstream fileName;
+      fileName << gameDir << "/" << type << "-" << (seed + i)
+	       << ((game->IsTree()) ? ".efg" : ".nfg");
+      std::ofstream file(fileName.str().c_str());
+      if (!file.is_open()) {
+	std::cerr << argv[0] << ": " << fileName.str() << ": " << strerror(errno) << std::endl;
+	return 1;
+      }
+      game->Write(file);
+    }
+    return 0;
+  }
+  catch (std::runtime_error &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -28,6 +28,7 @@
 #include <iomanip>
 #include <fstream>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 #include "libgambit/nash.h"
 
 using namespace Gambit;
@@ -613,6 +614,7 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -g MULT          granularity of grid refinement at each step (default is 2)\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          print statistics on the computation to standard error\n";
   std::cerr << "  -r DENOM         generate random starting points with denominator DENOM\n";
   std::cerr << "  -n COUNT         number of starting points to generate (requires -r)\n";
   std::cerr << "  -s FILE          file containing starting points\n";
@@ -631,16 +633,20 @@ int main(int argc, char *argv[])
   int randDenom = 1, gridResize = 2, stopAfter = 1;
   bool verbose = false, quiet = false;
 
+  int printStats = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
     { "verbose", 0, NULL, 'V'  },
+    { "stats", 0, &printStats, 1 },
     { 0,    0,    0,    0   }
   };
   int c;
   while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qS", long_options, &long_opt_index)) != -1) {
     switch (c) {
+    case 0:
+      break;
     case 'v':
       PrintBanner(std::cerr); exit(1);
     case 'g':
@@ -698,7 +704,9 @@ int main(int argc, char *argv[])
   }
 
   try {
+    Statistics::BeginPhase("read");
     Game game = ReadGame(*input_stream);
+    Statistics::BeginPhase("solve");
     List<MixedStrategyProfile<Rational> > starts;
     if (startFile != "") {
       std::ifstream startPoints(startFile.c_str());
@@ -721,6 +729,9 @@ int main(int argc, char *argv[])
 					  renderer);
       algorithm.Solve(starts[i]);
     }
+    if (printStats) {
+      Statistics::WriteJSON(std::cerr);
+    }
     return 0;
   }
   catch (std::runtime_error &e) {